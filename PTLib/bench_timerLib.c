@@ -0,0 +1,146 @@
+// bench_timerLib.c: per-fire latency & CPU use - SIGEV_THREAD vs timerfd + epoll loops vs signalfd dispatcher vs queue
+//   - N periodic Timers of one period, their phases spread over it, running for a few seconds
+//   - latency: a call-back's time - the latest expiration due (start + exp + k * period)
+//   - CPU: user + system, in % of a core; threads: the most seen (/proc/self/status) while running
+//   - control: a pause + resume of each Timer, per call - after the run
+//   - results: CSV on stdout, a line per {backend, timers}
+//
+//   usage: PTLibBench [max timers: 4096] [period ms: 10] [seconds: 3] [epoll loops: 1] [dispatcher cpu: none]
+//
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <sys/resource.h>
+
+#include "timerLib.h"
+
+#define LAT_BUCKETS   10000                                             // 1 micro each: the last - 10 millis & over
+
+typedef struct {
+   uint64_t   _due_ns ;                                                 // the 1st expiration due: CLOCK_MONOTONIC
+   uint64_t   _period_ns ;
+} BenchTimer_t ;
+
+static uint64_t   fires = 0, lat_sum_ns = 0, lat_max_ns = 0 ;
+static uint64_t   lat_hist[LAT_BUCKETS] ;
+
+// helpers
+
+static uint64_t now_ns(clockid_t clock)
+{
+   struct timespec   ts ; clock_gettime(clock, &ts) ;
+   return (uint64_t)ts.tv_sec * NANOS_IN_SEC + ts.tv_nsec ;
+}
+
+static uint64_t cpu_ns(void)                                             // user + system: the process'
+{
+   struct rusage   ru ; getrusage(RUSAGE_SELF, &ru) ;
+   return ((uint64_t)ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * NANOS_IN_SEC
+          + ((uint64_t)ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) * 1000 ;
+}
+
+static int count_threads(void)
+{
+   char   line[128] ; int  n = 0 ;
+   FILE*  f = fopen("/proc/self/status", "r") ;
+   if (!f)   return 0 ;
+   while (fgets(line, sizeof(line), f))
+      if (sscanf(line, "Threads: %d", &n) == 1)   break ;
+   fclose(f) ;
+   return n ;
+}
+
+static uint64_t percentile(uint64_t count, double p)                    // in micros
+{
+   uint64_t   rank = (uint64_t)(count * p), seen = 0 ;
+   for (uint64_t b = 0 ; b < LAT_BUCKETS ; ++b)
+      if ((seen += lat_hist[b]) > rank)   return b ;
+   return LAT_BUCKETS ;
+}
+
+static void bench_call_back(wTimer_t* wt, void* data)
+{
+   BenchTimer_t*  bt = (BenchTimer_t *)data ;
+   uint64_t       now = now_ns(wt->_clock) ;
+   uint64_t       lat = now > bt->_due_ns ? (now - bt->_due_ns) % bt->_period_ns : 0 ;
+   uint64_t       b = lat / 1000 < LAT_BUCKETS ? lat / 1000 : LAT_BUCKETS - 1 ;
+
+   __atomic_fetch_add(&fires, 1, __ATOMIC_RELAXED), __atomic_fetch_add(&lat_sum_ns, lat, __ATOMIC_RELAXED) ;
+   __atomic_fetch_add(&lat_hist[b], 1, __ATOMIC_RELAXED) ;
+   for (uint64_t m = __atomic_load_n(&lat_max_ns, __ATOMIC_RELAXED) ; lat > m ; )
+      if (__atomic_compare_exchange_n(&lat_max_ns, &m, lat, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))   break ;
+}
+
+static void bench(wTimerBackend_t backend, uint32_t loops, uint32_t n, uint64_t period, uint32_t seconds)
+{
+   wTimer_t*      ts = (wTimer_t *)calloc(n, sizeof(wTimer_t)) ;
+   BenchTimer_t*  bts = (BenchTimer_t *)calloc(n, sizeof(BenchTimer_t)) ;
+   if (!ts || !bts || !w_timer_set_backend(backend, loops)) {
+      fprintf(stderr, "> bench(): no backend %d or, out of memory\n", backend) ;
+      free(ts), free(bts) ;
+      return ;
+   }
+   fires = lat_sum_ns = lat_max_ns = 0, memset(lat_hist, 0, sizeof(lat_hist)) ;
+
+   uint32_t   started = 0 ;
+   for (uint32_t i = 0 ; i < n ; ++i) {                                  // phases: over the period
+      uint64_t   exp = period + i % period ;
+      if (!w_timer_initialize(CLOCK_MONOTONIC, &ts[i], bench_call_back, &bts[i], exp, period, false, 0))   break ;
+      bts[i]._due_ns = now_ns(CLOCK_MONOTONIC) + exp * WTIMER_NANOS_IN_UNIT, bts[i]._period_ns = period * WTIMER_NANOS_IN_UNIT ;
+      if (!w_timer_start(&ts[i]))   break ;
+      ++started ;
+   }
+
+   uint64_t   wall0 = now_ns(CLOCK_MONOTONIC), cpu0 = cpu_ns() ;
+   int        threads = 0 ;
+   while (now_ns(CLOCK_MONOTONIC) - wall0 < seconds * NANOS_IN_SEC) {
+      int  t = count_threads() ;
+      if (t > threads)   threads = t ;
+      usleep(10000) ;
+   }
+   uint64_t   wall = now_ns(CLOCK_MONOTONIC) - wall0, cpu = cpu_ns() - cpu0 ;
+
+   uint64_t   ctl0 = now_ns(CLOCK_MONOTONIC) ;
+   for (uint32_t i = 0 ; i < started ; ++i)   w_timer_pause(&ts[i]), w_timer_resume(&ts[i]) ;
+   uint64_t   ctl = started ? (now_ns(CLOCK_MONOTONIC) - ctl0) / (2 * started) : 0 ;
+
+   for (uint32_t i = 0 ; i < n ; ++i)   w_timer_delete(&ts[i]) ;
+   usleep(100000) ;                                                      // SIGEV_THREAD: the call-backs in flight
+
+   uint64_t   count = __atomic_load_n(&fires, __ATOMIC_RELAXED) ;
+   printf("%s,%u,%u,%lu,%lu,%.2f,%lu,%lu,%.2f,%.1f,%d,%lu\n",
+          backend == WTIMER_TIMERFD ? "timerfd" : backend == WTIMER_SIGNALFD ? "signalfd" :
+          backend == WTIMER_QUEUE ? "queue" : "sigev_thread",
+          n, started, period, count, count ? lat_sum_ns / 1000.0 / count : 0.0,
+          percentile(count, 0.5), percentile(count, 0.99), lat_max_ns / 1000.0, cpu * 100.0 / wall, threads, ctl) ;
+   fflush(stdout) ;
+   free(ts), free(bts) ;
+}
+
+int main(int argc, char* argv[])
+{
+   uint32_t   max_timers = argc > 1 ? (uint32_t)atoi(argv[1]) : 4096 ;
+   uint64_t   period = argc > 2 ? (uint64_t)atoi(argv[2]) : 10 ;
+   uint32_t   seconds = argc > 3 ? (uint32_t)atoi(argv[3]) : 3 ;
+   uint32_t   loops = argc > 4 ? (uint32_t)atoi(argv[4]) : 1 ;
+   int        cpu = argc > 5 ? atoi(argv[5]) : -1 ;
+
+   if (cpu >= 0 && !(w_timer_set_backend(WTIMER_SIGNALFD, 0) && w_timer_pin_dispatcher(cpu)))
+      fprintf(stderr, "> dispatcher: not pinned to %d\n", cpu) ;
+
+   printf("backend,timers,started,period_ms,fires,lat_mean_us,lat_p50_us,lat_p99_us,lat_max_us,cpu_pct,max_threads,ctl_ns_per_call\n") ;
+   for (uint32_t n = 1 ; n <= max_timers ; n *= 16) {
+      bench(WTIMER_SIGEV_THREAD, 0, n, period, seconds) ;
+      bench(WTIMER_TIMERFD, loops, n, period, seconds) ;
+      bench(WTIMER_SIGNALFD, 0, n, period, seconds) ;
+      bench(WTIMER_QUEUE, max_timers, n, period, seconds) ;
+   }
+   w_timer_shutdown() ;
+   return 0 ;
+}
+
+// eof bench_timerLib.c
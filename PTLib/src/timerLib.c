@@ -3,60 +3,637 @@
 //     - call-back is called asynchronously through a thread
 //                    (see struct sigevent::sigev_notify = SIGEV_THREAD)
 //     - parameters are passed through sigevent::sigval::sival_ptr(wTimer_t *)::_user_data
+//   Or, as selected by w_timer_set_backend():
+//     - WTIMER_TIMERFD: a timerfd per Timer, its expirations read by a fixed set of epoll loop threads
+//                    (no thread spawned per expiration); epoll_event::data: {generation, entry} of the loop's
+//     - WTIMER_SIGNALFD: a POSIX timer, WTIMER_SIGNAL aimed at one dispatcher thread (SIGEV_THREAD_ID)
+//                    drained in batches through a signalfd; sigval: {generation, entry} of the dispatcher's
+//     - WTIMER_QUEUE: no kernel timer per Timer - a min-heap of logical ones (an arena, preallocated),
+//                    a single timerfd armed for the earliest deadline; start/pause/resume/cancel in user space
 //
 
+#define _GNU_SOURCE                                                      // SIGEV_THREAD_ID, pthread_sigqueue(), ...
+
 #include "timerLib.h"
 
+#include <errno.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/syscall.h>
+#include <sys/timerfd.h>
+
+#ifndef sigev_notify_thread_id                                          // glibc < 2.35
+#define sigev_notify_thread_id   _sigev_un._tid
+#endif
+
+#define WTIMER_MAX_LOOPS      16
+#define WTIMER_LOOP_EVENTS    64                                        // per epoll_wait() or, signalfd read()
+#define WTIMER_NIL            UINT32_MAX
+#define WTIMER_STOP           UINT64_MAX                                // a loop's eventfd or, the dispatcher's signal
+
+typedef struct {                  // a Timer watched: stale events (deleted meanwhile) by the generation
+   wTimer_t*  _wt ;
+   uint32_t   _gen ;
+   uint32_t   _next_free ;
+} wTimerEntry_t ;
+
+struct wTimerLoop_ {              // an epoll loop or, the signalfd dispatcher: its Timers by {generation, entry}
+   pthread_t        _th ;
+   pid_t            _tid ;                                              // the dispatcher's: SIGEV_THREAD_ID
+   int              _epfd ;                                             // ... the signalfd
+   int              _evfd ;                                             // to stop a loop
+   pthread_mutex_t  _m ;                                                // the entries & _running
+   pthread_cond_t   _cv ;                                               // a call-back done: see _entry_remove()
+   wTimerEntry_t*   _entries ;
+   uint32_t         _cap ;
+   uint32_t         _free ;                                             // free entries: a list
+   wTimer_t*        _running ;                                          // its call-back running
+} ;
+
+static wTimerBackend_t      _backend = WTIMER_SIGEV_THREAD ;
+static struct wTimerLoop_   _loops[WTIMER_MAX_LOOPS] ;
+static uint32_t             _count_loops = 0 ;
+static uint32_t             _next_loop = 0 ;                            // Timers: round-robin over the loops
+static struct wTimerLoop_   _dispatcher ;                               // WTIMER_SIGNALFD
+static bool                 _has_dispatcher = false ;
+
+typedef struct {                  // a logical Timer of the queue
+   wTimer_t*  _wt ;
+   uint64_t   _due_ns ;                                                 // CLOCK_MONOTONIC
+   uint64_t   _period_ns ;
+   uint32_t   _pos ;                                                    // in the heap: WTIMER_NIL - not armed
+   uint32_t   _next_free ;
+} wTimerQEntry_t ;
+
+struct wTimerQueue_ {             // WTIMER_QUEUE
+   pthread_t        _th ;
+   int              _tfd ;                                              // the kernel timer: absolute
+   bool             _stop ;
+   pthread_mutex_t  _m ;                                                // all of it
+   pthread_cond_t   _cv ;                                               // a call-back done: see _queue_detach()
+   wTimerQEntry_t*  _entries ;                                          // the arena: preallocated
+   uint32_t*        _heap ;                                             // entries: a min-heap by _due_ns
+   uint32_t         _cap ;
+   uint32_t         _size ;                                             // # in the heap
+   uint32_t         _free ;                                             // free entries: a list
+   uint64_t         _armed_ns ;                                         // the kernel timer's: 0 - disarmed
+   wTimer_t*        _running ;                                          // its call-back running
+} ;
+
+static struct wTimerQueue_  _queue ;
+static bool                 _has_queue = false ;
+
 // internal functions
 
+static void _fire(wTimer_t* wt)                                         // either backend: User's call-back
+{
+   if (w_timer_state(wt) == TIMER_RESUMED && wt->_period != 0) w_timer_set_state(wt, TIMER_RUNNING) ;
+
+   wt->_cb(wt, wt->_user_args) ;
+}
+
    // function wrapper of User's call-back: used with SIGEV_THREAD
    // => sv.sival_ptr is used (expected to point to wTimer_t)
 static void _callback_wrapper(union sigval sv) {
    wTimer_t*  wt = (wTimer_t *)(sv.sival_ptr) ; assert(wt) ;
-   if (w_timer_state(wt) == TIMER_RESUMED && wt->_period != 0) w_timer_set_state(wt, TIMER_RUNNING) ;
-
-   wt->_cb(wt, wt->_user_args) ;
+   _fire(wt) ;
 }
 
   // arm/disarm Timer according to what's in ::_ts
-  //            use POSIX timer_settime(); @return - if succesful
+  //            use POSIX timer_settime() or, timerfd_settime(); @return - if succesful
+static bool _queue_arm(wTimer_t* wt) ;
+
 static bool _timer_arm_disarm(wTimer_t* wt)
 {
    // assert(wt) ;
+   if (wt->_backend == WTIMER_QUEUE)   return _queue_arm(wt) ;           // a syscall: if the head changed only
+   if (wt->_backend == WTIMER_TIMERFD)
+      return timerfd_settime(wt->_fd, 0, &(wt->_ts), NULL) == 0 ;        // a pending expiration: cleared as well
    return timer_settime(wt->_t, 0, &(wt->_ts), NULL) == 0 ;              // see timer_settime() for details
 }
 
+  // a loop's entries: under its lock
+static bool _entry_add(struct wTimerLoop_* l, wTimer_t* wt)             // @return - if successful: wt->_slot
+{
+   if (l->_free == WTIMER_NIL) {                                         // more entries: twice as many
+      uint32_t        cap = l->_cap ? 2 * l->_cap : 64 ;
+      wTimerEntry_t*  es = (wTimerEntry_t *)realloc(l->_entries, cap * sizeof(wTimerEntry_t)) ;
+      if (!es)   return false ;
+
+      for (uint32_t i = l->_cap ; i < cap ; ++i)
+         es[i]._wt = NULL, es[i]._gen = 0, es[i]._next_free = i + 1 < cap ? i + 1 : WTIMER_NIL ;
+      l->_entries = es, l->_free = l->_cap, l->_cap = cap ;
+   }
+   wTimerEntry_t*  e = &(l->_entries[l->_free]) ;
+   wt->_loop = l, wt->_slot = l->_free ;
+   l->_free = e->_next_free, e->_wt = wt ;
+   return true ;
+}
+
+static uint64_t _entry_key(wTimer_t* wt)                                // {generation, entry}: epoll data, sigval
+{ return (uint64_t)wt->_loop->_entries[wt->_slot]._gen << 32 | wt->_slot ; }
+
+  // events pending for it: stale; its call-back done, unless called by it (or, another one of the loop)
+static void _entry_remove(struct wTimerLoop_* l, wTimer_t* wt)
+{
+   wTimerEntry_t*  e = &(l->_entries[wt->_slot]) ;
+   e->_wt = NULL, ++e->_gen, e->_next_free = l->_free, l->_free = wt->_slot ;
+
+   while (l->_running == wt && !pthread_equal(pthread_self(), l->_th))   pthread_cond_wait(&l->_cv, &l->_m) ;
+   wt->_loop = NULL ;
+}
+
+  // an expiration of {generation, entry}: User's call-back, unlocked - may delete Timers of its loop
+static void _dispatch(struct wTimerLoop_* l, uint64_t key)
+{
+   uint32_t   slot = (uint32_t)key, gen = (uint32_t)(key >> 32) ;
+   uint64_t   fires = 0 ;
+
+   pthread_mutex_lock(&l->_m) ;                                          // deleted meanwhile: stale
+   wTimer_t*  wt = slot < l->_cap && l->_entries[slot]._gen == gen ? l->_entries[slot]._wt : NULL ;
+   if (wt && wt->_backend == WTIMER_TIMERFD && read(wt->_fd, &fires, sizeof(fires)) != sizeof(fires))
+      wt = NULL ;                                                        // re-armed meanwhile
+   l->_running = wt ;
+   pthread_mutex_unlock(&l->_m) ;
+   if (!wt)   return ;
+
+   _fire(wt) ;
+
+   pthread_mutex_lock(&l->_m) ;
+   l->_running = NULL, pthread_cond_broadcast(&l->_cv) ;
+   pthread_mutex_unlock(&l->_m) ;
+}
+
+  // epoll loop: a call-back per readable timerfd, the expirations read meanwhile coalesced (as SIGEV_THREAD overruns)
+static void* _loop_run(void* arg)
+{
+   struct wTimerLoop_*  l = (struct wTimerLoop_ *)arg ;
+   struct epoll_event   evs[WTIMER_LOOP_EVENTS] ;
+
+   for ( ; ; ) {
+      int  n = epoll_wait(l->_epfd, evs, WTIMER_LOOP_EVENTS, -1) ;
+      if (n < 0 && errno == EINTR)   continue ;
+      if (n < 0)   return NULL ;
+
+      for (int i = 0 ; i < n ; ++i) {
+         if (evs[i].data.u64 == WTIMER_STOP)   return NULL ;
+         _dispatch(l, evs[i].data.u64) ;
+      }
+   }
+}
+
+static bool _loop_start(struct wTimerLoop_* l)
+{
+   memset(l, 0, sizeof(*l)) ;
+   l->_free = WTIMER_NIL, l->_evfd = -1 ;
+   if ((l->_epfd = epoll_create1(EPOLL_CLOEXEC)) < 0)   return false ;
+
+   struct epoll_event  ev ; memset(&ev, 0, sizeof(ev)) ;
+   ev.events = EPOLLIN, ev.data.u64 = WTIMER_STOP ;
+   if ((l->_evfd = eventfd(0, EFD_CLOEXEC)) < 0 || epoll_ctl(l->_epfd, EPOLL_CTL_ADD, l->_evfd, &ev) != 0) {
+      if (l->_evfd >= 0)   close(l->_evfd) ;
+      close(l->_epfd) ;
+      return false ;
+   }
+   pthread_mutex_init(&l->_m, NULL), pthread_cond_init(&l->_cv, NULL) ;
+   if (pthread_create(&l->_th, NULL, _loop_run, l) == 0)   return true ;
+
+   pthread_mutex_destroy(&l->_m), pthread_cond_destroy(&l->_cv) ;
+   close(l->_evfd), close(l->_epfd) ;
+   return false ;
+}
+
+  // w_timer_shutdown(): a Timer still attached - deleted, as by w_timer_delete(); its thread: joined already
+static void _orphan(wTimer_t* wt)
+{
+   wt->_loop = NULL, wt->_slot = WTIMER_NIL ;
+   w_timer_set_state(wt, TIMER_DELETED) ;
+}
+
+static void _loop_stop(struct wTimerLoop_* l)
+{
+   uint64_t  one = 1 ;
+   if (write(l->_evfd, &one, sizeof(one)) == sizeof(one))   pthread_join(l->_th, NULL) ;
+
+   for (uint32_t i = 0 ; i < l->_cap ; ++i) {                            // its Timers: their timerfds closed
+      wTimer_t*  wt = l->_entries[i]._wt ;
+      if (wt)   close(wt->_fd), wt->_fd = -1, _orphan(wt) ;
+   }
+   close(l->_evfd), close(l->_epfd) ;
+   pthread_mutex_destroy(&l->_m), pthread_cond_destroy(&l->_cv) ;
+   free(l->_entries), l->_entries = NULL ;
+}
+
+  // watch wt->_fd: on the next loop; @return - if successful
+static bool _loop_attach(wTimer_t* wt)
+{
+   struct wTimerLoop_*  l = &_loops[__atomic_fetch_add(&_next_loop, 1, __ATOMIC_RELAXED) % _count_loops] ;
+
+   pthread_mutex_lock(&l->_m) ;
+   bool  res = _entry_add(l, wt) ;
+   if (res) {
+      struct epoll_event  ev ; memset(&ev, 0, sizeof(ev)) ;
+      ev.events = EPOLLIN, ev.data.u64 = _entry_key(wt) ;
+      if (!(res = epoll_ctl(l->_epfd, EPOLL_CTL_ADD, wt->_fd, &ev) == 0))   _entry_remove(l, wt) ;
+   }
+   pthread_mutex_unlock(&l->_m) ;
+   return res ;
+}
+
+  // unwatch & close wt->_fd
+static void _loop_detach(wTimer_t* wt)
+{
+   struct wTimerLoop_*  l = wt->_loop ;
+
+   pthread_mutex_lock(&l->_m) ;
+   epoll_ctl(l->_epfd, EPOLL_CTL_DEL, wt->_fd, NULL) ;
+   close(wt->_fd), wt->_fd = -1 ;
+   _entry_remove(l, wt) ;
+   pthread_mutex_unlock(&l->_m) ;
+}
+
+  // signalfd dispatcher: WTIMER_SIGNAL, aimed at it by SIGEV_THREAD_ID - the pending ones drained in batches
+static void* _dispatcher_run(void* arg)
+{
+   struct wTimerLoop_*       l = (struct wTimerLoop_ *)arg ;
+   struct signalfd_siginfo   sis[WTIMER_LOOP_EVENTS] ;
+
+   pthread_mutex_lock(&l->_m) ;
+   l->_tid = (pid_t)syscall(SYS_gettid), pthread_cond_broadcast(&l->_cv) ;
+   pthread_mutex_unlock(&l->_m) ;
+
+   for ( ; ; ) {
+      ssize_t  n = read(l->_epfd, sis, sizeof(sis)) ;                    // blocks: this thread's signal, blocked
+      if (n < 0 && errno == EINTR)   continue ;
+      if (n <= 0)   return NULL ;
+
+      for (size_t i = 0 ; i < (size_t)n / sizeof(sis[0]) ; ++i) {        // overruns (ssi_overrun): coalesced
+         if (sis[i].ssi_ptr == WTIMER_STOP)   return NULL ;
+         _dispatch(l, sis[i].ssi_ptr) ;
+      }
+   }
+}
+
+static bool _dispatcher_start(struct wTimerLoop_* l)
+{
+   sigset_t  mask, old ;
+   sigemptyset(&mask), sigaddset(&mask, WTIMER_SIGNAL) ;
+
+   memset(l, 0, sizeof(*l)) ;
+   l->_free = WTIMER_NIL, l->_evfd = -1 ;
+   if ((l->_epfd = signalfd(-1, &mask, SFD_CLOEXEC)) < 0)   return false ;
+   pthread_mutex_init(&l->_m, NULL), pthread_cond_init(&l->_cv, NULL) ;
+
+   pthread_sigmask(SIG_BLOCK, &mask, &old) ;                             // inherited: blocked from its start
+   bool  res = pthread_create(&l->_th, NULL, _dispatcher_run, l) == 0 ;
+   pthread_sigmask(SIG_SETMASK, &old, NULL) ;
+   if (!res) {
+      pthread_mutex_destroy(&l->_m), pthread_cond_destroy(&l->_cv) ;
+      close(l->_epfd) ;
+      return false ;
+   }
+
+   pthread_mutex_lock(&l->_m) ;                                          // its tid: to aim the Timers at
+   while (l->_tid == 0)   pthread_cond_wait(&l->_cv, &l->_m) ;
+   pthread_mutex_unlock(&l->_m) ;
+   return true ;
+}
+
+static void _dispatcher_stop(struct wTimerLoop_* l)
+{
+   union sigval  sv ; sv.sival_ptr = (void *)(uintptr_t)WTIMER_STOP ;
+
+   pthread_mutex_lock(&l->_m) ;                                          // its Timers: no signal once it's gone
+   for (uint32_t i = 0 ; i < l->_cap ; ++i)   if (l->_entries[i]._wt)   timer_delete(l->_entries[i]._wt->_t) ;
+   pthread_mutex_unlock(&l->_m) ;
+   if (pthread_sigqueue(l->_th, WTIMER_SIGNAL, sv) == 0)   pthread_join(l->_th, NULL) ;
+
+   for (uint32_t i = 0 ; i < l->_cap ; ++i)   if (l->_entries[i]._wt)   _orphan(l->_entries[i]._wt) ;
+   close(l->_epfd) ;
+   pthread_mutex_destroy(&l->_m), pthread_cond_destroy(&l->_cv) ;
+   free(l->_entries), l->_entries = NULL ;
+}
+
+  // a POSIX timer, its signal aimed at the dispatcher: sigval - {generation, entry}; @return - if successful
+static bool _dispatcher_attach(wTimer_t* wt)
+{
+   struct wTimerLoop_*  l = &_dispatcher ;
+   struct sigevent      wev ; memset(&wev, 0, sizeof(wev)) ;
+
+   pthread_mutex_lock(&l->_m) ;
+   bool  res = _entry_add(l, wt) ;
+   if (res) {
+      wev.sigev_notify = SIGEV_THREAD_ID, wev.sigev_signo = WTIMER_SIGNAL, wev.sigev_notify_thread_id = l->_tid ;
+      wev.sigev_value.sival_ptr = (void *)(uintptr_t)_entry_key(wt) ;
+      if (!(res = timer_create(wt->_clock, &wev, &(wt->_t)) == 0))   _entry_remove(l, wt) ;
+   }
+   pthread_mutex_unlock(&l->_m) ;
+   return res ;
+}
+
+static void _dispatcher_detach(wTimer_t* wt)
+{
+   struct wTimerLoop_*  l = wt->_loop ;
+
+   pthread_mutex_lock(&l->_m) ;
+   timer_delete(wt->_t) ;                                                // its signal, if queued: stale
+   _entry_remove(l, wt) ;
+   pthread_mutex_unlock(&l->_m) ;
+}
+
+
+  // WTIMER_QUEUE: logical Timers in a min-heap of deadlines over a preallocated arena - one timerfd armed for its head
+static uint64_t _mono_ns(void)
+{
+   struct timespec   ts ; clock_gettime(CLOCK_MONOTONIC, &ts) ;
+   return timespec_to_nanos(&ts) ;
+}
+
+static void _q_place(struct wTimerQueue_* q, uint32_t pos, uint32_t ix)
+{ q->_heap[pos] = ix, q->_entries[ix]._pos = pos ; }
+
+static void _q_sift_up(struct wTimerQueue_* q, uint32_t pos)
+{
+   uint32_t   ix = q->_heap[pos] ;
+   uint64_t   due = q->_entries[ix]._due_ns ;
+   for ( ; pos > 0 ; ) {
+      uint32_t   parent = (pos - 1) / 2 ;
+      if (q->_entries[q->_heap[parent]]._due_ns <= due)   break ;
+      _q_place(q, pos, q->_heap[parent]), pos = parent ;
+   }
+   _q_place(q, pos, ix) ;
+}
+
+static void _q_sift_down(struct wTimerQueue_* q, uint32_t pos)
+{
+   uint32_t   ix = q->_heap[pos] ;
+   uint64_t   due = q->_entries[ix]._due_ns ;
+   for ( ; ; ) {
+      uint32_t   child = 2 * pos + 1 ;
+      if (child >= q->_size)   break ;
+      if (child + 1 < q->_size && q->_entries[q->_heap[child + 1]]._due_ns < q->_entries[q->_heap[child]]._due_ns)   ++child ;
+      if (due <= q->_entries[q->_heap[child]]._due_ns)   break ;
+      _q_place(q, pos, q->_heap[child]), pos = child ;
+   }
+   _q_place(q, pos, ix) ;
+}
+
+static void _q_push(struct wTimerQueue_* q, uint32_t ix)
+{ _q_place(q, q->_size, ix), _q_sift_up(q, q->_size++) ; }
+
+static void _q_remove(struct wTimerQueue_* q, uint32_t ix)                // if in the heap
+{
+   uint32_t   pos = q->_entries[ix]._pos ;
+   if (pos == WTIMER_NIL)   return ;
+
+   uint32_t   last = q->_heap[--q->_size] ;
+   q->_entries[ix]._pos = WTIMER_NIL ;
+   if (pos == q->_size)   return ;
+   _q_place(q, pos, last), _q_sift_up(q, pos), _q_sift_down(q, q->_entries[last]._pos) ;
+}
+
+static void _q_rearm(struct wTimerQueue_* q)                              // the kernel timer: if the head changed only
+{
+   uint64_t   head = q->_size ? q->_entries[q->_heap[0]]._due_ns : 0 ;
+   if (head == q->_armed_ns)   return ;
+
+   struct itimerspec   its ; memset(&its, 0, sizeof(its)) ;
+   its.it_value.tv_sec = head / NANOS_IN_SEC, its.it_value.tv_nsec = head % NANOS_IN_SEC ;
+   timerfd_settime(q->_tfd, TFD_TIMER_ABSTIME, &its, NULL) ;
+   q->_armed_ns = head ;
+}
+
+  // the queue's thread: the due ones fired one at a time, unlocked - periodic: the missed periods coalesced
+static void* _queue_run(void* arg)
+{
+   struct wTimerQueue_*  q = (struct wTimerQueue_ *)arg ;
+   uint64_t              fires = 0 ;
+
+   pthread_mutex_lock(&q->_m) ;
+   while (!q->_stop) {
+      uint64_t   now = _mono_ns() ;
+      if (q->_size == 0 || q->_entries[q->_heap[0]]._due_ns > now) {
+         _q_rearm(q) ;
+         pthread_mutex_unlock(&q->_m) ;
+         ssize_t  n = read(q->_tfd, &fires, sizeof(fires)) ;             // blocks: till the head's due
+         pthread_mutex_lock(&q->_m) ;
+         if (n == sizeof(fires))   q->_armed_ns = 0 ;                    // expired: disarmed
+         continue ;
+      }
+
+      uint32_t         ix = q->_heap[0] ;
+      wTimerQEntry_t*  e = &(q->_entries[ix]) ;
+      wTimer_t*        wt = e->_wt ;
+      _q_remove(q, ix) ;
+      if (e->_period_ns)
+         e->_due_ns += ((now - e->_due_ns) / e->_period_ns + 1) * e->_period_ns, _q_push(q, ix) ;
+
+      q->_running = wt ;
+      pthread_mutex_unlock(&q->_m) ;
+      _fire(wt) ;                                                        // may control or delete any Timer
+      pthread_mutex_lock(&q->_m) ;
+      q->_running = NULL, pthread_cond_broadcast(&q->_cv) ;
+   }
+   pthread_mutex_unlock(&q->_m) ;
+   return NULL ;
+}
+
+static bool _queue_start(struct wTimerQueue_* q, uint32_t capacity)
+{
+   memset(q, 0, sizeof(*q)) ;
+   q->_entries = (wTimerQEntry_t *)calloc(capacity, sizeof(wTimerQEntry_t)) ;
+   q->_heap = (uint32_t *)calloc(capacity, sizeof(uint32_t)) ;
+   q->_tfd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC) ;
+   if (!q->_entries || !q->_heap || q->_tfd < 0) {
+      if (q->_tfd >= 0)   close(q->_tfd) ;
+      free(q->_entries), free(q->_heap) ;
+      return false ;
+   }
+   for (uint32_t i = 0 ; i < capacity ; ++i)
+      q->_entries[i]._pos = WTIMER_NIL, q->_entries[i]._next_free = i + 1 < capacity ? i + 1 : WTIMER_NIL ;
+   q->_cap = capacity, q->_free = 0 ;
+
+   pthread_mutex_init(&q->_m, NULL), pthread_cond_init(&q->_cv, NULL) ;
+   if (pthread_create(&q->_th, NULL, _queue_run, q) == 0)   return true ;
+
+   pthread_mutex_destroy(&q->_m), pthread_cond_destroy(&q->_cv) ;
+   close(q->_tfd), free(q->_entries), free(q->_heap) ;
+   return false ;
+}
+
+static void _queue_stop(struct wTimerQueue_* q)
+{
+   struct itimerspec   its ; memset(&its, 0, sizeof(its)) ;
+   its.it_value.tv_nsec = 1 ;                                            // long passed: wakes it up
+
+   pthread_mutex_lock(&q->_m) ;
+   q->_stop = true ;
+   timerfd_settime(q->_tfd, TFD_TIMER_ABSTIME, &its, NULL) ;
+   pthread_mutex_unlock(&q->_m) ;
+   pthread_join(q->_th, NULL) ;
+
+   for (uint32_t i = 0 ; i < q->_cap ; ++i)   if (q->_entries[i]._wt)   _orphan(q->_entries[i]._wt) ;
+   close(q->_tfd) ;
+   pthread_mutex_destroy(&q->_m), pthread_cond_destroy(&q->_cv) ;
+   free(q->_entries), free(q->_heap), q->_entries = NULL, q->_heap = NULL ;
+}
+
+static bool _queue_attach(wTimer_t* wt)                                 // an entry of the arena: no syscall
+{
+   struct wTimerQueue_*  q = &_queue ;
+
+   pthread_mutex_lock(&q->_m) ;
+   bool  res = q->_free != WTIMER_NIL ;                                  // full: as many as its capacity
+   if (res) {
+      wTimerQEntry_t*  e = &(q->_entries[q->_free]) ;
+      wt->_slot = q->_free, q->_free = e->_next_free ;
+      e->_wt = wt, e->_pos = WTIMER_NIL ;
+   }
+   pthread_mutex_unlock(&q->_m) ;
+   return res ;
+}
+
+static void _queue_detach(wTimer_t* wt)                                 // its call-back done, unless called by it
+{
+   struct wTimerQueue_*  q = &_queue ;
+   wTimerQEntry_t*       e = &(q->_entries[wt->_slot]) ;
+
+   pthread_mutex_lock(&q->_m) ;
+   _q_remove(q, wt->_slot), _q_rearm(q) ;
+   e->_wt = NULL, e->_next_free = q->_free, q->_free = wt->_slot ;
+   while (q->_running == wt && !pthread_equal(pthread_self(), q->_th))   pthread_cond_wait(&q->_cv, &q->_m) ;
+   pthread_mutex_unlock(&q->_m) ;
+}
+
+static bool _queue_arm(wTimer_t* wt)                                    // as per ::_ts: the kernel timer - if the head changed
+{
+   struct wTimerQueue_*  q = &_queue ;
+   wTimerQEntry_t*       e = &(q->_entries[wt->_slot]) ;
+   uint64_t              value = timespec_to_nanos(&(wt->_ts.it_value)) ;
+
+   pthread_mutex_lock(&q->_m) ;
+   _q_remove(q, wt->_slot) ;
+   if (value)                                                            // else: disarmed
+      e->_due_ns = _mono_ns() + value, e->_period_ns = timespec_to_nanos(&(wt->_ts.it_interval)), _q_push(q, wt->_slot) ;
+   _q_rearm(q) ;
+   pthread_mutex_unlock(&q->_m) ;
+   return true ;
+}
+
+static uint64_t _queue_ns_to_fire(wTimer_t* wt)
+{
+   struct wTimerQueue_*  q = &_queue ;
+   wTimerQEntry_t*       e = &(q->_entries[wt->_slot]) ;
+   uint64_t              now = _mono_ns(), res = 0 ;
+
+   pthread_mutex_lock(&q->_m) ;
+   if (e->_pos != WTIMER_NIL)   res = e->_due_ns > now ? e->_due_ns - now : 1 ;   // armed: never 0, see w_timer_resume()
+   pthread_mutex_unlock(&q->_m) ;
+   return res ;
+}
 
 // APIs follow
 
+bool w_timer_set_backend(wTimerBackend_t backend, uint32_t n)
+{
+   if (backend == WTIMER_TIMERFD && _count_loops == 0) {                 // the epoll loops: the 1st time only
+      uint32_t   loops = n == 0 ? 1 : n > WTIMER_MAX_LOOPS ? WTIMER_MAX_LOOPS : n ;
+      for (uint32_t i = 0 ; i < loops ; ++i) {
+         if (!_loop_start(&_loops[i])) {                                // the ones just started only
+            while (_count_loops)   _loop_stop(&_loops[--_count_loops]) ;
+            return false ;
+         }
+         ++_count_loops ;
+      }
+   }
+   if (backend == WTIMER_SIGNALFD && !_has_dispatcher) {                 // the dispatcher: ... as well
+      if (!(_has_dispatcher = _dispatcher_start(&_dispatcher)))   return false ;
+   }
+   if (backend == WTIMER_QUEUE && !_has_queue) {                         // the queue: its arena
+      if (!(_has_queue = _queue_start(&_queue, n ? n : 4096)))   return false ;
+   }
+   _backend = backend ;
+   return true ;
+}
+
+wTimerBackend_t w_timer_get_backend(void)
+{
+   return _backend ;
+}
+
+bool w_timer_pin_dispatcher(int cpu)
+{
+   if (!_has_dispatcher || cpu < 0 || cpu >= CPU_SETSIZE)   return false ;
+
+   cpu_set_t   cpus ; CPU_ZERO(&cpus) ; CPU_SET(cpu, &cpus) ;
+   return pthread_setaffinity_np(_dispatcher._th, sizeof(cpus), &cpus) == 0 ;
+}
+
+void w_timer_shutdown(void)
+{
+   for (uint32_t i = 0 ; i < _count_loops ; ++i)   _loop_stop(&_loops[i]) ;
+   if (_has_dispatcher)   _dispatcher_stop(&_dispatcher) ;
+   if (_has_queue)   _queue_stop(&_queue) ;
+   _count_loops = 0, _has_dispatcher = _has_queue = false, _backend = WTIMER_SIGEV_THREAD ;
+}
+
 // initialize wTimer_t, @return - ther result
 //      settings: SIGEV_THREAD for notifying: see $ man sigevent
+//                or, a timerfd watched by an epoll loop, SIGEV_THREAD_ID to the dispatcher: see w_timer_set_backend()
 
 bool w_timer_initialize(clockid_t clock,                                 // clock to be used
                         wTimer_t* wt, wTimerCB_t cb, void* ua,           // timer to initialize, callback, user args
                         uint64_t exp, uint64_t period, bool is_exp,      // expiration, next period, is exponential
                         uint32_t mf)                                     // max # of fires
+{
+   return w_timer_initialize_ns(clock, wt, cb, ua, exp * WTIMER_NANOS_IN_UNIT, period * WTIMER_NANOS_IN_UNIT, is_exp, mf) ;
+}
+
+bool w_timer_initialize_ns(clockid_t clock,                              // ... in nano-seconds: _exp & _period too,
+                           wTimer_t* wt, wTimerCB_t cb, void* ua,        //     truncated to milli-secs
+                           uint64_t exp_ns, uint64_t period_ns, bool is_exp,
+                           uint32_t mf)
 {
    assert(wt && cb) ;
    wt->_state = TIMER_DELETED ;
 
    wt->_clock = clock,
-   wt->_cb = cb, wt->_user_args = ua, wt->_exp = exp, wt->_period = period,
+   wt->_cb = cb, wt->_user_args = ua, wt->_exp = exp_ns / WTIMER_NANOS_IN_UNIT, wt->_period = period_ns / WTIMER_NANOS_IN_UNIT,
+   wt->_exp_ns = exp_ns, wt->_period_ns = period_ns, wt->_time_remaining = wt->_time_remaining_ns = 0,
    wt->_is_exponential = is_exp, wt->_exp_back_off = 0, wt->_max_fires = mf ;
+   wt->_backend = _backend, wt->_fd = -1, wt->_loop = NULL ;
 
-   struct sigevent  wev ; memset(&wev, 0, sizeof(wev)) ;                 // for timer_t modes: notification, etc
+   if (wt->_backend == WTIMER_TIMERFD) {                                 // a timerfd: on one of the epoll loops
+      if ((wt->_fd = timerfd_create(wt->_clock, TFD_NONBLOCK | TFD_CLOEXEC)) < 0)   return false ;
+      if (!_loop_attach(wt)) { close(wt->_fd), wt->_fd = -1 ; return false ; }
+   }
+   else if (wt->_backend == WTIMER_SIGNALFD) {                           // a POSIX timer: aimed at the dispatcher
+      if (!_dispatcher_attach(wt))   return false ;
+   }
+   else if (wt->_backend == WTIMER_QUEUE) {                              // a logical one: in the queue's arena
+      if (!_queue_attach(wt))   return false ;
+   }
+   else {
+      struct sigevent  wev ; memset(&wev, 0, sizeof(wev)) ;              // for timer_t modes: notification, etc
 
-   // create a POSIX timer: see man sigevent
-   wev.sigev_notify = SIGEV_THREAD, wev.sigev_notify_function = _callback_wrapper ;
-   wev.sigev_value.sival_ptr = wt ;                                      // to be used wthin call-back
-   if (timer_create(wt->_clock, &wev, &(wt->_t)) != 0)   return false ;  // POSIX timer_create might fail
+      // create a POSIX timer: see man sigevent
+      wev.sigev_notify = SIGEV_THREAD, wev.sigev_notify_function = _callback_wrapper ;
+      wev.sigev_value.sival_ptr = wt ;                                   // to be used wthin call-back
+      if (timer_create(wt->_clock, &wev, &(wt->_t)) != 0)   return false ; // POSIX timer_create might fail
+   }
 
-   millis_into_timespec(wt->_exp, &(wt->_ts.it_value)),                  // expiration
-   millis_into_timespec(wt->_period, &(wt->_ts.it_interval)) ;           // & period(if any)
+   nanos_into_timespec(wt->_exp_ns, &(wt->_ts.it_value)),                // expiration
+   nanos_into_timespec(wt->_period_ns, &(wt->_ts.it_interval)) ;         // & period(if any)
 
    wt->_state = TIMER_INIT ;
    return true ;
-} // w_timer_initialize()
+} // w_timer_initialize_ns()
 
 // w_timer_start(): from States BUT: _DELETED,
 bool w_timer_start(wTimer_t* wt)
@@ -70,12 +647,19 @@ bool w_timer_start(wTimer_t* wt)
 }
 
 unsigned long w_timer_ms_to_fire(wTimer_t* wt)
+{
+   return w_timer_ns_to_fire(wt) / WTIMER_NANOS_IN_UNIT ;
+}
+
+uint64_t w_timer_ns_to_fire(wTimer_t* wt)
 {
    assert(wt) ;
    struct itimerspec   its ; memset(&its, 0, sizeof(its)) ;
 
-   timer_gettime(wt->_t, &its) ;                                         // the remainning T would be in ::it_value
-   return timespec_to_millis(&(its.it_value)) ;
+   if (wt->_backend == WTIMER_QUEUE)   return _queue_ns_to_fire(wt) ;
+   if (wt->_backend == WTIMER_TIMERFD)   timerfd_gettime(wt->_fd, &its) ;
+   else   timer_gettime(wt->_t, &its) ;                                  // the remainning T would be in ::it_value
+   return timespec_to_nanos(&(its.it_value)) ;
 }
 
 void w_timer_pause(wTimer_t* wt)                                         // pause a running Timer, @return - if successful
@@ -84,7 +668,8 @@ void w_timer_pause(wTimer_t* wt)                                         // paus
           (w_timer_state(wt) == TIMER_RUNNING || w_timer_state(wt) == TIMER_RESUMED)
          ) ;
 
-   wt->_time_remaining = w_timer_ms_to_fire(wt) ;
+   wt->_time_remaining_ns = w_timer_ns_to_fire(wt) ;                     // exact: ::_time_remaining - in millis
+   wt->_time_remaining = wt->_time_remaining_ns / WTIMER_NANOS_IN_UNIT ;
    millis_into_timespec(0, &(wt->_ts.it_value)), millis_into_timespec(0, &(wt->_ts.it_interval)) ;
    _timer_arm_disarm(wt), w_timer_set_state(wt, TIMER_PAUSED) ;          // stop POSIX Timer & set state in T.
 }
@@ -93,9 +678,9 @@ void w_timer_resume(wTimer_t* wt)                                        // resu
 {
    assert(wt && w_timer_state(wt) == TIMER_PAUSED) ;
 
-   millis_into_timespec(wt->_time_remaining, &(wt->_ts.it_value)),       // reset time to fire
-   millis_into_timespec(wt->_period, &(wt->_ts.it_interval)) ;           // reset period
-   wt->_time_remaining = 0 ;
+   nanos_into_timespec(wt->_time_remaining_ns, &(wt->_ts.it_value)),     // reset time to fire: 0 - fired (one-time)
+   nanos_into_timespec(wt->_period_ns, &(wt->_ts.it_interval)) ;         // reset period
+   wt->_time_remaining = wt->_time_remaining_ns = 0 ;
 
    _timer_arm_disarm(wt), w_timer_set_state(wt, TIMER_RESUMED) ;         // stop POSIX Timer & set state in T.
 }
@@ -103,9 +688,10 @@ void w_timer_resume(wTimer_t* wt)                                        // resu
 
 void w_timer_cancel(wTimer_t* wt)                                        // cancel a running Timer, @return - if successful
 {
-   assert(wt && w_timer_state(wt) != TIMER_INIT && w_timer_state(wt) != TIMER_DELETED) ;
+   assert(wt && w_timer_state(wt) != TIMER_INIT) ;
+   if (w_timer_state(wt) == TIMER_DELETED)   return ;                    // by w_timer_shutdown(): nothing armed
 
-   wt->_time_remaining = 0, // just in case or, clear all dynamic attrs
+   wt->_time_remaining = wt->_time_remaining_ns = 0, // just in case or, clear all dynamic attrs
    millis_into_timespec(0, &(wt->_ts.it_value)), millis_into_timespec(0, &(wt->_ts.it_interval)) ;
    _timer_arm_disarm(wt), w_timer_set_state(wt, TIMER_CANCELLED) ;       // stop POSIX Timer & set state in T.
 }
@@ -120,7 +706,12 @@ void w_timer_delete(wTimer_t* wt)                                        // canc
       w_timer_cancel(wt) ;
    }
 
-   // ??? clean all
+   if (state != TIMER_DELETED) {                                         // release the timer itself
+      if (wt->_backend == WTIMER_TIMERFD)   _loop_detach(wt) ;
+      else if (wt->_backend == WTIMER_SIGNALFD)   _dispatcher_detach(wt) ;
+      else if (wt->_backend == WTIMER_QUEUE)   _queue_detach(wt) ;
+      else   timer_delete(wt->_t) ;
+   }
 
    w_timer_set_state(wt, TIMER_DELETED) ;       // mark it INOPERATIONAL
 }
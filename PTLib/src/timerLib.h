@@ -16,14 +16,25 @@
 
 #define NANOS_IN_SEC          1000000000L
 #define WTIMER_UNITS_IN_SEC   1000                                      // defines the Units: milli-secs here
-#define WTIMER_UNITS_IN_NANOS (WTIMER_UNITS_IN_SEC / NANOS_IN_SEC)      // multiplier nano-s to units
-#define WTIMER_NANOS_IN_UNIT  (NANOS_IN_SEC / WTIMER_UNITS_IN_SEC)
+#define WTIMER_NANOS_IN_UNIT  (NANOS_IN_SEC / WTIMER_UNITS_IN_SEC)      // nano-s to units: a division by
+
+#ifndef WTIMER_SIGNAL
+#define WTIMER_SIGNAL         (SIGRTMIN + 4)                             // WTIMER_SIGNALFD: not to be used otherwise
+#endif
 
 typedef enum { TIMER_INIT, TIMER_RUNNING, TIMER_PAUSED,
                TIMER_CANCELLED, TIMER_DELETED, TIMER_RESUMED,
                TIMER_ERROR
 } wTimerState_t ;
 
+typedef enum { WTIMER_SIGEV_THREAD,                                      // POSIX timer: glibc's thread per expiration
+               WTIMER_TIMERFD,                                           // timerfd: read by a few epoll loop threads
+               WTIMER_SIGNALFD,                                          // POSIX timer: a signal to one dispatcher thread
+               WTIMER_QUEUE                                              // logical: a heap over one kernel timer
+} wTimerBackend_t ;
+
+struct wTimerLoop_ ;                                                     // an epoll loop: see timerLib.c
+
 
 typedef struct Timer_xxx_ {
 
@@ -36,34 +47,62 @@ typedef struct Timer_xxx_ {
   bool      _is_exponential ;
   clockid_t _clock ;                                                     // clock type
 
+  uint64_t  _exp_ns ;                                                    // as _exp & _period: in nano-seconds
+  uint64_t  _period_ns ;
+
   // dynamic attributes
   uint32_t  _count_fires ;                                               // count of fires
   uint64_t  _time_remaining ;                                            // at when being paused
+  uint64_t  _time_remaining_ns ;                                         // ... exact: resumed with it
 
   struct itimerspec  _ts ; // the expiration time needed to start it up
   uint64_t  _exp_back_off ; // for exponential timers
 
   wTimerState_t _state ;
 
+  wTimerBackend_t      _backend ;                                        // as selected when initialized
+  int                  _fd ;                                             // WTIMER_TIMERFD: its timerfd
+  struct wTimerLoop_*  _loop ;                                           // ... the epoll loop watching it (or, dispatcher)
+  uint32_t             _slot ;                                           // ... its entry in there
+
 } wTimer_t ;   // a wrapper arond POSIX timer: all periods in milli-seconds
 
 typedef void (* wTimerCB_t)(wTimer_t *, void *) ;
 
 // APIs
 
+// select the backend of the Timers initialized from now on (WTIMER_SIGEV_THREAD - by default); @return - if successful
+//        WTIMER_TIMERFD: the 1st time, starts 'n' epoll threads (0 - one), the Timers spread over them
+//                        call-backs: on those threads, one at a time per loop - expirations meanwhile coalesced
+//        WTIMER_SIGNALFD: the 1st time, starts the dispatcher thread ('n' - ignored): all call-backs on it,
+//                        WTIMER_SIGNAL drained through a signalfd in batches - overruns coalesced
+//        WTIMER_QUEUE: the 1st time, an arena of 'n' Timers (0 - 4096) & the queue's thread: all call-backs on it;
+//                        deadlines on CLOCK_MONOTONIC, missed periods coalesced
+bool w_timer_set_backend(wTimerBackend_t backend, uint32_t n) ;
+wTimerBackend_t w_timer_get_backend(void) ;                              // ... the current one: to be restored
+bool w_timer_pin_dispatcher(int cpu) ;                                   // WTIMER_SIGNALFD: its thread to 'cpu' only
+void w_timer_shutdown(void) ;                                            // stops the loops, ... queue: their Timers
+                                                                         // ... DELETED - w_timer_delete(): a no-op
+
 // initialize a Timer into wTimer_t; @return - if successful
 //            if successfule - the state is set to _INIT
 bool w_timer_initialize(clockid_t clock,                                 // clock to be used
                         wTimer_t* t, wTimerCB_t cb, void* ua,            // timer to initialize, callback, user args
                         uint64_t exp, uint64_t period, bool is_exp,      // expiration, next period, is exponential
                         uint32_t mf) ;                                   // max # of fires
+bool w_timer_initialize_ns(clockid_t clock,                              // ... in nano-seconds: exp & period
+                           wTimer_t* t, wTimerCB_t cb, void* ua,
+                           uint64_t exp_ns, uint64_t period_ns, bool is_exp,
+                           uint32_t mf) ;
 
 bool w_timer_start(wTimer_t* wt) ;                                       // starts wTimer as per ::_ts
 unsigned long w_timer_ms_to_fire(wTimer_t* wt) ;                         // milli-secs to next 'fire'
+uint64_t w_timer_ns_to_fire(wTimer_t* wt) ;                              // nano-secs to next 'fire'
 void w_timer_pause(wTimer_t* wt) ;                                       // pause a running Timer
 void w_timer_resume(wTimer_t* wt) ;                                      // resume a paused Timer
 void w_timer_cancel(wTimer_t* wt) ;                                      // cancel(stop) a Timer: can be started
-void w_timer_delete(wTimer_t* wt) ;                                      // (stop &) delete a Timer:
+void w_timer_delete(wTimer_t* wt) ;                                      // (stop &) delete a Timer: its call-back
+                                                                         // ... done, if on an epoll loop
 
 static inline wTimerState_t w_timer_state(wTimer_t* t)                   // returns the current state
 { return t->_state ; }
@@ -73,11 +112,17 @@ static inline wTimerState_t w_timer_set_state(wTimer_t* t, wTimerState_t st) //
 
 
 // helpers
-static inline uint64_t timespec_to_millis(struct timespec* ts)            // @return: ts in milli-secs: enough with Linux
-{ return ts->tv_sec * WTIMER_UNITS_IN_SEC + ts->tv_nsec * WTIMER_UNITS_IN_NANOS ; }
+static inline uint64_t timespec_to_millis(const struct timespec* ts)      // @return: ts in milli-secs, truncated
+{ return (uint64_t)ts->tv_sec * WTIMER_UNITS_IN_SEC + (uint64_t)ts->tv_nsec / WTIMER_NANOS_IN_UNIT ; }
 
-static void millis_into_timespec(uint64_t ms, struct timespec* ts)        // milli_secs into timerspec
+static inline void millis_into_timespec(uint64_t ms, struct timespec* ts) // milli_secs into timerspec
 { ts->tv_sec = ms / WTIMER_UNITS_IN_SEC, ts->tv_nsec = (ms % WTIMER_UNITS_IN_SEC) * WTIMER_NANOS_IN_UNIT ; }
 
+static inline uint64_t timespec_to_nanos(const struct timespec* ts)       // @return: ts in nano-secs: exact, 584 years
+{ return (uint64_t)ts->tv_sec * NANOS_IN_SEC + (uint64_t)ts->tv_nsec ; }
+
+static inline void nanos_into_timespec(uint64_t ns, struct timespec* ts)  // nano-secs into timespec: exact
+{ ts->tv_sec = (time_t)(ns / NANOS_IN_SEC), ts->tv_nsec = (long)(ns % NANOS_IN_SEC) ; }
+
 
 #endif // TIMERLIB_H
@@ -6,6 +6,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
+#include <math.h>
 
 #include <sys/time.h>
 #include <sys/types.h>
@@ -26,11 +27,17 @@ unsigned long long v_time_ns_lapse(struct timespec* t1, struct timespec* t0) ;
 
 
 void usr_call_back(wTimer_t* wt, void* data) ;
+bool test_period_ns(wTimerBackend_t backend) ;
+bool test_shutdown(void) ;
 
 int main()
 {
     printf("\n> Hello World! [main() thread id: %d]", gettid());
 
+    for (int b = WTIMER_SIGEV_THREAD ; b <= WTIMER_QUEUE ; ++b)
+       if (!test_period_ns((wTimerBackend_t)b))   return 1 ;
+    if (!test_shutdown())   return 1 ;
+
     Menu_t  menu_txt = { 0, "1)Pause 2)Resume 3)Restart 4)Reschedule 5)Cancel 6)Remaining Time 7)Quit: " } ;
 
     wTimer_t   timer ;
@@ -104,6 +111,133 @@ void usr_call_back(wTimer_t *wt, void *data)
    }
 } */
 
+                                  // a 100 micros period: its accuracy as achieved, pause/resume in nano-seconds
+                                  //   - jitter & mean: reported, not judged - the scheduler's; a late or missed fire
+                                  //     stretches the mean: the median interval judged, within 10%
+                                  //   - a Timer & its records per backend: a late SIGEV_THREAD call-back (one spawned
+                                  //     before w_timer_delete()) lands in its own, never in the next backend's
+#define PERIOD_NS   100000ULL
+#define MAX_FIRES   8192
+#define FIRES       5000                                                 // before the pause: half a second
+
+typedef struct {
+   struct timespec   _at[MAX_FIRES] ;
+   uint32_t          _count ;
+   uint32_t          _inflight ;                                         // call-backs entered, not returned
+} Fires_t ;
+
+static void record_call_back(wTimer_t* wt, void* data)
+{
+   Fires_t*  f = (Fires_t *)data ;
+   __atomic_fetch_add(&f->_inflight, 1, __ATOMIC_ACQ_REL) ;
+   uint32_t  i = __atomic_fetch_add(&f->_count, 1, __ATOMIC_RELAXED) ;
+   if (i < MAX_FIRES)   clock_gettime(wt->_clock, &f->_at[i]) ;
+   __atomic_fetch_sub(&f->_inflight, 1, __ATOMIC_RELEASE) ;
+}
+
+static int by_value(const void* a, const void* b)
+{
+   uint64_t   x = *(const uint64_t *)a, y = *(const uint64_t *)b ;
+   return x < y ? -1 : x > y ;
+}
+
+static bool wait_for(const uint32_t* counter, uint32_t at_least, uint32_t at_most, uint64_t within_ns)
+{                                                                        // polled: @return - if in [at_least, at_most]
+   struct timespec   now ;
+   clock_gettime(CLOCK_MONOTONIC, &now) ;
+   uint64_t   deadline = timespec_to_nanos(&now) + within_ns ;
+   for (uint32_t c ; ; usleep(100)) {
+      c = __atomic_load_n(counter, __ATOMIC_ACQUIRE) ;
+      if (c >= at_least && c <= at_most)   return true ;
+      clock_gettime(CLOCK_MONOTONIC, &now) ;
+      if (timespec_to_nanos(&now) > deadline)   return false ;
+   }
+}
+
+bool test_period_ns(wTimerBackend_t backend)
+{
+   static Fires_t    fires[WTIMER_QUEUE + 1] ;
+   static wTimer_t   timers[WTIMER_QUEUE + 1] ;
+   static uint64_t   intervals[MAX_FIRES] ;
+   Fires_t*          f = &fires[backend] ;
+   wTimer_t*         t = &timers[backend] ;
+   const char*       names[] = { "sigev_thread", "timerfd", "signalfd", "queue" } ;
+   wTimerBackend_t   previous = w_timer_get_backend() ;                  // restored: the global one
+
+   memset(f, 0, sizeof(*f)) ;
+   bool   started = w_timer_set_backend(backend, 0) &&
+                    w_timer_initialize_ns(CLOCK_MONOTONIC, t, record_call_back, f, PERIOD_NS, PERIOD_NS, false, 0) ;
+   w_timer_set_backend(previous, 0) ;                                    // as selected when initialized: kept by t
+   if (!started || !w_timer_start(t)) {
+      printf("\n> 100us period (%s): not started", names[backend]) ;
+      return false ;
+   }
+   bool       enough = wait_for(&f->_count, FIRES, UINT32_MAX, 4 * FIRES * PERIOD_NS) ;
+   w_timer_pause(t) ;                                                    // less than a period left: not 0, nor millis
+   uint64_t   left = t->_time_remaining_ns ;
+   uint32_t   paused = __atomic_load_n(&f->_count, __ATOMIC_RELAXED) ;
+   usleep(20000) ;                                                       // 200 periods: none of them to fire
+   bool       still = __atomic_load_n(&f->_count, __ATOMIC_RELAXED) <= paused + 1 ;
+   w_timer_resume(t) ;
+   bool       resumed = wait_for(&f->_count, paused + 11, UINT32_MAX, 1000 * PERIOD_NS) ;
+   w_timer_delete(t) ;
+   bool       drained = wait_for(&f->_inflight, 0, 0, 1000 * PERIOD_NS) ;   // the ones in flight: returned
+
+   uint32_t   n = paused < MAX_FIRES ? paused : MAX_FIRES ;
+   uint64_t   max_dev = 0 ;
+   double     sum_sq = 0 ;
+   for (uint32_t i = 1 ; i < n ; ++i) {
+      uint64_t   d = timespec_to_nanos(&f->_at[i]) - timespec_to_nanos(&f->_at[i - 1]) ;
+      intervals[i - 1] = d ;
+      uint64_t   dev = d > PERIOD_NS ? d - PERIOD_NS : PERIOD_NS - d ;
+      if (dev > max_dev)   max_dev = dev ;
+      sum_sq += (double)dev * dev ;
+   }
+   double     mean = n > 1 ? (double)(timespec_to_nanos(&f->_at[n - 1]) - timespec_to_nanos(&f->_at[0])) / (n - 1) : 0 ;
+   if (n > 1)   qsort(intervals, n - 1, sizeof(intervals[0]), by_value) ;
+   uint64_t   median = n > 1 ? intervals[(n - 1) / 2] : 0 ;
+   bool       ok = enough && n > 1 && median > PERIOD_NS * 0.9 && median < PERIOD_NS * 1.1 && left > 0 && left <= PERIOD_NS
+                   && still && resumed && drained && w_timer_get_backend() == previous ;
+   printf("\n> 100us period (%s): %u fires, median %.2fus, mean %.2fus, jitter (rms) %.2fus, max deviation %.2fus; "
+          "paused with %.2fus left: %s", names[backend], n, median / 1000.0, mean / 1000,
+          n > 1 ? sqrt(sum_sq / (n - 1)) / 1000 : 0.0, max_dev / 1000.0, left / 1000.0, ok ? "OK" : "FAILED") ;
+   fflush(stdout) ;
+   return ok ;
+}
+
+static void count_call_back(wTimer_t* wt, void* data)
+{
+   (void)wt ;
+   __atomic_fetch_add((uint32_t *)data, 1, __ATOMIC_RELAXED) ;
+}
+
+                                  // Timers still running: deleted by w_timer_shutdown() - delete & cancel, no-ops
+bool test_shutdown(void)
+{
+   static wTimer_t   timers[WTIMER_QUEUE + 1] ;
+   static uint32_t   fired ;
+   bool              ok = true ;
+
+   for (int b = WTIMER_TIMERFD ; b <= WTIMER_QUEUE ; ++b)
+      ok = ok && w_timer_set_backend((wTimerBackend_t)b, 0)
+              && w_timer_initialize_ns(CLOCK_MONOTONIC, &timers[b], count_call_back, &fired, PERIOD_NS, PERIOD_NS, false, 0)
+              && w_timer_start(&timers[b]) ;
+   bool       running = ok && wait_for(&fired, 30, UINT32_MAX, 1000 * PERIOD_NS) ;
+   w_timer_shutdown() ;
+   uint32_t   at_shutdown = __atomic_load_n(&fired, __ATOMIC_RELAXED) ;
+
+   for (int b = WTIMER_TIMERFD ; ok && b <= WTIMER_QUEUE ; ++b) {
+      ok = w_timer_state(&timers[b]) == TIMER_DELETED && timers[b]._loop == NULL ;
+      w_timer_cancel(&timers[b]), w_timer_delete(&timers[b]) ;
+   }
+   usleep(10000) ;                                                       // 100 periods: none of them to fire
+   ok = ok && running && __atomic_load_n(&fired, __ATOMIC_RELAXED) == at_shutdown
+           && w_timer_get_backend() == WTIMER_SIGEV_THREAD ;
+   printf("\n> shutdown: 3 backends, %u fires, then none; their Timers deleted: %s", at_shutdown, ok ? "OK" : "FAILED") ;
+   fflush(stdout) ;
+   return ok ;
+}
+
 // helpers
 
 unsigned long long v_time_ns_lapse(struct timespec* t1, struct timespec* t0)   // t1 >= t0
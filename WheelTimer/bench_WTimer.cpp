@@ -0,0 +1,397 @@
+// bench_WTimer.cpp: micro-benchmarks - throughput of insert, expire, cancel & reschedule
+//   - cWTimerEventsDB_: on its own (the owner's operations), flat & hierarchical wheels
+//   - cWTimer_: 1 to N producer threads (posted), expiry as measured by the Timer's work-load
+//   - registering: register_events() vs a register_event() loop, posted & in place; a group of shards, a producer each
+//   - cWTimerStatic_ vs cWTimer_ on a virtual clock: the same geometry, compile-time vs run-time, on the owner's thread
+//   - populations: 10^2 .. 10^max, periods: uniform or skewed (most of them near, a long tail)
+//   - results: CSV on stdout, a line per {target, op, backend, distribution, population, producers}
+//   - slack: non-empty slots & ticks run (tickless wake-ups) as timers are given some, a CSV of its own
+//   - sources: the tick sources - the Timer's wake-up jitter, CPU & context switches (the process'), a CSV of its own
+//   - callables: a call-back's invocation cost - AppCB_, AppCallable_ (both paths), std::function, a CSV of its own
+//
+//   usage: WheelTimerBench [max population exponent: 6] [max producers: hardware concurrency]
+//          WheelTimerBench slack [max population exponent: 6]
+//          WheelTimerBench sources [period micros: 1000] [seconds: 5]
+//          WheelTimerBench callables [calls: 50000000]
+//
+
+#include "Logger_decl.hpp"
+#include "Logger_helpers.hpp"
+
+#include "src/wheel_timer.hpp"
+#include "src/wt_group.hpp"
+#include "src/wt_static.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <iostream>
+
+#include <pthread.h>
+#include <sys/resource.h>
+
+#if WTIMER_PTLIB
+extern "C" {
+#include "timerLib.h"                                          // the PTLIB source: its backends
+}
+#endif
+
+using Clock = std::chrono::steady_clock ;
+
+void* do_nothing(void*, size_t) { return nullptr ; }
+
+constexpr uint32_t   SLOTS = 4096 ;                            // level 0 of the wheels benched
+constexpr uint32_t   SPAN = 65536 ;                            // periods: [1, SPAN) ticks
+
+std::vector<uint32_t> make_periods(size_t n, bool skewed, uint32_t span, uint64_t seed)
+{
+   std::mt19937_64                          rng{seed} ;
+   std::uniform_int_distribution<uint32_t>   uniform{1, span - 1} ;
+   std::exponential_distribution<double>     near{64.0 / span} ;  // mean: span / 64
+
+   std::vector<uint32_t>   periods(n) ;
+   for (auto& p : periods)
+      p = skewed ? 1 + std::min<uint32_t>((uint32_t)near(rng), span - 2) : uniform(rng) ;
+   return periods ;
+}
+
+void report(const char* target, const char* op, const char* backend, bool skewed,
+            size_t population, uint32_t producers, size_t ops, Clock::duration lapse)
+{
+   auto   ns = std::chrono::duration<double, std::nano>(lapse).count() ;
+   std::cout << target << ',' << op << ',' << backend << ',' << (skewed ? "skewed" : "uniform") << ','
+             << population << ',' << producers << ',' << ops << ',' << (ops ? ns / ops : 0.0) << ','
+             << (ns > 0 ? ops * 1e3 / ns : 0.0) << std::endl ;
+}
+
+                                  // cWTimerEventsDB_: the owner's (Timer's thread) operations
+void bench_db(uint32_t levels, bool skewed, size_t n)
+{
+   const char*   backend = levels ? "hierarchical" : "flat" ;
+   auto          periods = make_periods(n, skewed, SPAN, n) ;
+   auto          later = make_periods(n, skewed, SPAN, n + 1) ;
+   std::vector<size_t>   order(n) ;                            // cancel & reschedule: in random order
+   for (size_t i = 0 ; i < n ; ++i)   order[i] = i ;
+   std::shuffle(order.begin(), order.end(), std::mt19937_64{n}) ;
+
+   cWTimerEventsDB_             db{SLOTS, levels} ;
+   std::vector<WTimerHandle_>   hs(n) ;
+   db.reserve(n + 1) ;
+
+   auto   add = [&db, &hs, &periods, n] {
+      for (size_t i = 0 ; i < n ; ++i) {
+         auto  when = db.now() + periods[i] ;
+         hs[i] = db.add_event(db.make_key(when / SLOTS, (uint32_t)(when % SLOTS)), cWTimerEvent_{periods[i], false, do_nothing}) ;
+      }
+   } ;
+
+   auto   start = Clock::now() ;
+   add() ;
+   report("db", "insert", backend, skewed, n, 1, n, Clock::now() - start) ;
+
+   start = Clock::now() ;
+   for (auto i : order)   db.reschedule(hs[i], later[i], true) ;
+   report("db", "reschedule", backend, skewed, n, 1, n, Clock::now() - start) ;
+
+   size_t   fired = 0 ;
+   start = Clock::now() ;
+   while (db.size() > 0) {                                     // tick by tick, as the Timer does
+      auto  r = db.now() / SLOTS ;
+      auto  t = (uint32_t)(db.now() % SLOTS) ;
+      for (auto nh = db.extract(r, t) ; nh ; nh = db.extract(r, t))   ++fired ;
+      db.advance() ;
+   }
+   report("db", "expire", backend, skewed, n, 1, fired, Clock::now() - start) ;
+
+   add() ;                                                     // again: the nodes recycled
+   start = Clock::now() ;
+   for (auto i : order)   db.cancel(hs[i], true) ;
+   report("db", "cancel", backend, skewed, n, 1, n, Clock::now() - start) ;
+}
+
+                                  // cWTimer_: registering threads, the Timer running
+template <typename F>
+Clock::duration in_parallel(uint32_t producers, F f)          // f(producer): all started at once
+{
+   std::vector<std::thread>   ths ;
+   std::atomic<bool>          go{false} ;
+   for (uint32_t p = 0 ; p < producers ; ++p)
+      ths.emplace_back([&go, &f, p] { while (!go.load(std::memory_order_acquire)) ; f(p) ; }) ;
+   auto   start = Clock::now() ;
+   go.store(true, std::memory_order_release) ;
+   for (auto& th : ths)   th.join() ;
+   return Clock::now() - start ;
+}
+
+void bench_timer(bool skewed, size_t n, uint32_t producers)
+{
+   auto   periods = make_periods(n, skewed, SPAN, n) ;
+   std::vector<WTimerHandle_>   hs(n) ;
+   auto   share = [n, producers](uint32_t p) { return std::make_pair(n * p / producers, n * (p + 1) / producers) ; } ;
+
+   {
+      cWTimer_   timer{SLOTS, 1, 0, false, "Bench", 2} ;
+      timer.log_ticks(false), timer.reserve(n + 1024) ;
+      timer.start() ;
+
+      auto   lapse = in_parallel(producers, [&](uint32_t p) {  // not due while benched: a rotation ahead at least
+         auto [from, to] = share(p) ;
+         for (auto i = from ; i < to ; ++i)   hs[i] = timer.register_event(cWTimerEvent_{SPAN + periods[i], false, do_nothing}) ;
+      }) ;
+      report("timer", "insert", "hierarchical", skewed, n, producers, n, lapse) ;
+
+      lapse = in_parallel(producers, [&](uint32_t p) {
+         auto [from, to] = share(p) ;
+         for (auto i = from ; i < to ; ++i)   timer.reschedule(hs[i], SPAN + periods[n - 1 - i]) ;
+      }) ;
+      report("timer", "reschedule", "hierarchical", skewed, n, producers, n, lapse) ;
+
+      lapse = in_parallel(producers, [&](uint32_t p) {
+         auto [from, to] = share(p) ;
+         for (auto i = from ; i < to ; ++i)   timer.cancel(hs[i]) ;
+      }) ;
+      report("timer", "cancel", "hierarchical", skewed, n, producers, n, lapse) ;
+      timer.stop() ;
+   }
+
+   if (producers != 1)   return ;                              // expiry: the Timer's thread only
+   cWTimer_   timer{SLOTS, 1, 0, true, "Bench", 2} ;           // debug: the work-load histogram
+   timer.log_ticks(false), timer.reserve(n + 1024) ;
+   auto   soon = make_periods(n, skewed, 256, n) ;             // due within a quarter of a second
+   for (size_t i = 0 ; i < n ; ++i)   timer.register_event(cWTimerEvent_{8 + soon[i], false, do_nothing, true}) ;
+   timer.start() ;
+   std::this_thread::sleep_for(std::chrono::milliseconds(5)) ; // the posted ones drained: not to be counted
+   timer.debug()._work_load.reset() ;
+   auto   fired = timer.stats()._fired ;
+
+   for (auto end = Clock::now() + std::chrono::seconds(30) ; timer.stats()._fired < n && Clock::now() < end ; )
+      std::this_thread::sleep_for(std::chrono::milliseconds(10)) ;
+   timer.stop() ;
+   auto   work = timer.debug()._work_load.take() ;
+   report("timer", "expire", "hierarchical", skewed, n, 1, timer.stats()._fired - fired, std::chrono::nanoseconds(work._sum)) ;
+}
+
+void bench_group(bool skewed, size_t n, uint32_t producers)   // a shard per producer, pinned: routed by the caller's CPU
+{
+   auto   periods = make_periods(n, skewed, SPAN, n) ;
+   auto   cpus = std::max(1u, std::thread::hardware_concurrency()) ;
+   std::vector<int>   pinned ;
+   for (uint32_t p = 0 ; p < producers ; ++p)   pinned.push_back((int)(p % cpus)) ;
+
+   cWTimerGroup_   group{pinned, SLOTS, 1, 2, "Bench"} ;
+   group.log_ticks(false), group.reserve(n / producers + 1024) ;
+   group.start() ;
+   auto   lapse = in_parallel(producers, [&](uint32_t p) {
+      cpu_set_t   set ;
+      CPU_ZERO(&set) ;
+      CPU_SET(pinned[p], &set) ;
+      pthread_setaffinity_np(pthread_self(), sizeof(set), &set) ;
+      for (auto i = n * p / producers ; i < n * (p + 1) / producers ; ++i)
+         group.register_event(cWTimerEvent_{SPAN + periods[i], false, do_nothing}) ;
+   }) ;
+   group.stop() ;
+   report("group", "insert", "hierarchical", skewed, n, producers, n, lapse) ;
+}
+
+void bench_bulk(bool skewed, size_t n)                         // register_events() vs a register_event() loop
+{
+   auto   periods = make_periods(n, skewed, SPAN, n) ;
+   for (bool owner : {false, true}) {                          // posted: a single push; in place: a splice per slot
+      cWTimer_   loop{SLOTS, 1, 0, false, "Bench", 2}, bulk{SLOTS, 1, 0, false, "Bench", 2} ;
+      std::vector<cWTimerEvent_>   evs ;
+      evs.reserve(n) ;
+      for (auto& t : {&loop, &bulk}) {
+         t->log_ticks(false), t->set_virtual(true), t->reserve(n + 1) ;
+         if (owner)   t->start(), t->advance(0) ;               // this thread: the Timer's
+      }
+
+      for (size_t i = 0 ; i < n ; ++i)   evs.emplace_back(periods[i], true, do_nothing) ;
+      auto   start = Clock::now() ;
+      for (auto& ev : evs)   loop.register_event(std::move(ev)) ;
+      report("timer", "insert_loop", owner ? "in_place" : "posted", skewed, n, 1, n, Clock::now() - start) ;
+
+      evs.clear() ;
+      for (size_t i = 0 ; i < n ; ++i)   evs.emplace_back(periods[i], true, do_nothing) ;
+      start = Clock::now() ;
+      auto   hs = bulk.register_events(evs) ;
+      report("timer", "insert_bulk", owner ? "in_place" : "posted", skewed, n, 1, hs.size(), Clock::now() - start) ;
+   }
+}
+
+                                  // cWTimerStatic_ vs cWTimer_ (virtual clock): the owner's operations, expiry included
+template <typename Timer>
+void bench_owner(Timer& timer, const char* target, const char* backend, bool skewed, size_t n)
+{
+   auto   periods = make_periods(n, skewed, SPAN, n) ;
+   auto   later = make_periods(n, skewed, SPAN, n + 1) ;
+   std::vector<size_t>   order(n) ;
+   for (size_t i = 0 ; i < n ; ++i)   order[i] = i ;
+   std::shuffle(order.begin(), order.end(), std::mt19937_64{n}) ;
+   std::vector<WTimerHandle_>   hs(n) ;
+
+   auto   add = [&timer, &hs, &periods, n] { for (size_t i = 0 ; i < n ; ++i)   hs[i] = timer.register_event(cWTimerEvent_{periods[i], false, do_nothing}) ; } ;
+
+   auto   start = Clock::now() ;
+   add() ;
+   report(target, "insert", backend, skewed, n, 1, n, Clock::now() - start) ;
+
+   start = Clock::now() ;
+   for (auto i : order)   timer.reschedule(hs[i], later[i]) ;
+   report(target, "reschedule", backend, skewed, n, 1, n, Clock::now() - start) ;
+
+   start = Clock::now() ;
+   auto   fired = timer.advance(SPAN) ;
+   report(target, "expire", backend, skewed, n, 1, fired, Clock::now() - start) ;
+
+   add() ;
+   start = Clock::now() ;
+   for (auto i : order)   timer.cancel(hs[i]) ;
+   report(target, "cancel", backend, skewed, n, 1, n, Clock::now() - start) ;
+}
+
+void bench_static(bool skewed, size_t n)
+{
+   for (uint32_t levels : {0u, 2u}) {
+      cWTimer_   timer{SLOTS, 1, 0, false, "Bench", levels} ;
+      timer.log_ticks(false), timer.set_virtual(true), timer.reserve(n + 1) ;
+      timer.start(), timer.advance(0) ;                        // this thread: the Timer's - registering in place
+      bench_owner(timer, "virtual", levels ? "hierarchical" : "flat", skewed, n) ;
+   }
+   cWTimerStatic_<SLOTS, 1000>   wheel ;
+   wheel.reserve(n + 1) ;
+   bench_owner(wheel, "static", "flat", skewed, n) ;
+}
+
+                                  // slack: a percentage of the period - fewer, fuller slots
+void bench_slack(bool skewed, size_t n, uint32_t pct)
+{
+   auto   periods = make_periods(n, skewed, SLOTS, n) ;          // within a rotation: a slot per due tick
+   cWTimer_   timer{SLOTS, 1, 0, false, "Bench", 0} ;
+   timer.log_ticks(false), timer.set_virtual(true), timer.reserve(n + 1) ;
+   timer.start(), timer.advance(0) ;
+   for (size_t i = 0 ; i < n ; ++i)
+      timer.register_event(cWTimerEvent_{periods[i], false, do_nothing, true, (uint32_t)((uint64_t)periods[i] * pct / 100)}) ;
+
+   auto   pop = timer.population() ;
+   auto   busy = std::count_if(pop.begin(), pop.end(), [](uint32_t c) { return c != 0 ; }) ;
+   auto   start = Clock::now() ;
+   auto   fired = timer.advance(2 * SLOTS) ;
+   auto   ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() ;
+   std::cout << (skewed ? "skewed" : "uniform") << ',' << n << ',' << pct << ',' << busy << ','
+             << timer.stats()._ticks << ',' << fired << ',' << (fired ? ns / fired : 0.0) << std::endl ;
+}
+
+                                  // call-backs: the cost of an invocation, in nano-seconds
+static volatile uint64_t   calls{0} ;                          // not to be optimized away
+void* count_call(void*, size_t) { calls = calls + 1 ; return nullptr ; }
+
+template <typename F>
+double ns_per_call(F& f, size_t n)
+{
+   auto start = Clock::now() ;
+   for (size_t i = 0 ; i < n ; ++i)   f() ;
+   return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / n ;
+}
+
+void bench_callables(size_t n)                                 // AppCB_ vs AppCallable_ vs std::function
+{
+   auto   lambda = [p = &calls, a = 1ull, b = 2ull] { *p = *p + a + b ; } ;   // some state: in place
+
+   AppCB_                  raw{count_call} ;
+   AppCallable_            fast{count_call} ;                  // the AppCB_ path
+   AppCallable_            erased{lambda} ;
+   std::function<void()>   func{lambda} ;
+
+   std::cout << "AppCB_," << n << ',' << ns_per_call(raw, n) << std::endl ;
+   std::cout << "AppCallable_{AppCB_}," << n << ',' << ns_per_call(fast, n) << std::endl ;
+   std::cout << "AppCallable_{lambda}," << n << ',' << ns_per_call(erased, n) << std::endl ;
+   std::cout << "std::function," << n << ',' << ns_per_call(func, n) << std::endl ;
+}
+
+                                  // tick sources: the Timer's wake-up jitter & the process' CPU, per tick
+void bench_source(WTickSource_ src, const char* name, std::chrono::microseconds period, uint32_t seconds,
+                  std::chrono::microseconds spin = {})
+{
+   std::atomic<uint64_t>   fired{0} ;
+   cWTimer_   timer{SLOTS, period, true, "Bench", 0, src} ;     // debug: the jitter & spin histograms
+   timer.log_ticks(false), timer.set_dispatch(1), timer.set_spin(spin) ;
+   for (uint32_t i = 0 ; i < 64 ; ++i)                           // a light load: a few firings per tick
+      timer.register_event(cWTimerEvent_{1 + i % 8, true, [&fired] { fired.fetch_add(1, std::memory_order_relaxed) ; }, true}) ;
+
+   rusage   ru0, ru1 ;
+   getrusage(RUSAGE_SELF, &ru0) ;
+   auto   start = Clock::now() ;
+   if (!timer.start()) { std::cout << name << ",not available" << std::endl ; return ; }
+   std::this_thread::sleep_for(std::chrono::seconds(seconds)) ;
+   timer.stop() ;
+   auto   wall = std::chrono::duration<double, std::nano>(Clock::now() - start).count() ;
+   getrusage(RUSAGE_SELF, &ru1) ;
+
+   auto   cpu_ns = [](const rusage& ru) { return (ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * 1e9
+                                                 + (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) * 1e3 ; } ;
+   auto   jitter = timer.debug()._jitter.snapshot() ;
+   auto   ticks = timer.stats()._ticks ;
+   std::cout << name << ',' << period.count() << ',' << spin.count() << ',' << ticks << ',' << jitter.mean() / 1000.0 << ','
+             << jitter.percentile(50) / 1000.0 << ',' << jitter.percentile(99) / 1000.0 << ','
+             << jitter.percentile(99.9) / 1000.0 << ',' << jitter._max / 1000.0 << ',' << timer.debug()._missed.load() << ','
+             << (cpu_ns(ru1) - cpu_ns(ru0)) * 100.0 / wall << ',' << (ticks ? (cpu_ns(ru1) - cpu_ns(ru0)) / ticks / 1000.0 : 0.0) << ','
+             << (ru1.ru_nvcsw + ru1.ru_nivcsw - ru0.ru_nvcsw - ru0.ru_nivcsw) << ','
+             << timer.debug()._spin.snapshot().percentile(50) / 1000.0 << std::endl ;
+}
+
+int main(int argc, char* argv[])
+{
+   if (argc > 1 && !std::strcmp(argv[1], "sources")) {
+      auto       period = std::chrono::microseconds{argc > 2 ? std::atoi(argv[2]) : 1000} ;
+      uint32_t   seconds = argc > 3 ? (uint32_t)std::atoi(argv[3]) : 5 ;
+      std::cout << "source,period_us,spin_us,ticks,jitter_mean_us,jitter_p50_us,jitter_p99_us,jitter_p999_us,jitter_max_us,"
+                   "missed,cpu_pct,cpu_us_per_tick,ctx_switches,spun_p50_us" << std::endl ;
+      bench_source(WTickSource_::CONDVAR, "condvar", period, seconds) ;
+      bench_source(WTickSource_::NANOSLEEP, "nanosleep", period, seconds) ;
+      bench_source(WTickSource_::TIMERFD, "timerfd", period, seconds) ;
+      for (auto spin : {25, 50, 75, 100})                          // hybrid: up to the whole period spun
+         bench_source(WTickSource_::HYBRID, "hybrid", period, seconds, std::min(period, std::chrono::microseconds{spin})) ;
+#if WTIMER_PTLIB
+      const std::pair<wTimerBackend_t, const char*>   backends[] = {
+         {WTIMER_SIGEV_THREAD, "ptlib/sigev_thread"}, {WTIMER_TIMERFD, "ptlib/timerfd"},
+         {WTIMER_SIGNALFD, "ptlib/signalfd"}, {WTIMER_QUEUE, "ptlib/queue"} } ;
+      for (auto [backend, name] : backends)
+         if (w_timer_set_backend(backend, 0))   bench_source(WTickSource_::PTLIB, name, period, seconds) ;
+      w_timer_shutdown() ;
+#endif
+      return 0 ;
+   }
+
+   if (argc > 1 && !std::strcmp(argv[1], "callables")) {
+      std::cout << "callable,calls,ns_per_call" << std::endl ;
+      bench_callables(argc > 2 ? (size_t)std::atoll(argv[2]) : 50'000'000) ;
+      return 0 ;
+   }
+
+   if (argc > 1 && !std::strcmp(argv[1], "slack")) {
+      int   max_exp = argc > 2 ? std::atoi(argv[2]) : 6 ;
+      std::cout << "distribution,population,slack_pct,busy_slots,ticks_run,fired,ns_per_fire" << std::endl ;
+      for (int e = 2 ; e <= max_exp ; ++e)
+         for (bool skewed : {false, true})
+            for (uint32_t pct : {0u, 1u, 5u, 12u, 25u})   bench_slack(skewed, (size_t)std::pow(10, e), pct) ;
+      return 0 ;
+   }
+
+   int        max_exp = argc > 1 ? std::atoi(argv[1]) : 6 ;
+   uint32_t   max_producers = argc > 2 ? (uint32_t)std::atoi(argv[2]) : std::max(1u, std::thread::hardware_concurrency()) ;
+
+   std::cout << "target,op,backend,distribution,population,producers,ops,ns_per_op,mops_per_s" << std::endl ;
+   for (int e = 2 ; e <= max_exp ; ++e) {
+      auto   n = (size_t)std::pow(10, e) ;
+      for (bool skewed : {false, true}) {
+         for (uint32_t levels : {0u, 2u})   bench_db(levels, skewed, n) ;
+         bench_static(skewed, n) ;
+         bench_bulk(skewed, n) ;
+         for (uint32_t p = 1 ; p <= max_producers ; p *= 2)   bench_timer(skewed, n, p), bench_group(skewed, n, p) ;
+      }
+   }
+   return 0 ;
+}
+
+// eof bench_WTimer.cpp
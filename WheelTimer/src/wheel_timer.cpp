@@ -4,17 +4,40 @@
 
 #include "wheel_timer.hpp"
 
+#include <algorithm>
+
+#include <time.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+
+static int64_t
+mono_time_ns()                                                          // CLOCK_MONOTONIC: the ticks' time-base
+{
+   timespec   ts{} ;
+   clock_gettime(CLOCK_MONOTONIC, &ts) ;
+   return ts.tv_sec * 1'000'000'000LL + ts.tv_nsec ;
+}
+
                                                                // cWTimer_:: functionality
                                   // cWTimer_:: constructors, destructor
 
-cWTimer_::cWTimer_(uint32_t capacity, uint32_t period, int dc,
-                   size_t deb_cap, std::string&& id)
-        : _capacity{capacity}, _period{period}, _delay_corr{dc}
+cWTimer_::cWTimer_(uint32_t capacity, uint32_t period, int /* obsolete */,
+                   bool debug, std::string&& id, uint32_t levels, WTickSource_ source)
+        : cWTimer_{capacity, std::chrono::milliseconds{period}, debug, std::move(id), levels, source}
+{
+
+}
+
+cWTimer_::cWTimer_(uint32_t capacity, std::chrono::microseconds period,
+                   bool debug, std::string&& id, uint32_t levels, WTickSource_ source)
+        : _capacity{capacity}, _period{period}
         , _id{std::move(id)}                                             // description
         , _th{}, _sstop{}                                                // the Timer
         , _tick{0}, _rotation{0}                                         // current state
-        , _events{}                                                      // the Scheduled
-        , _isOK{false}, _deb_coll{deb_cap, capacity}
+        , _events{capacity, levels}                                      // the Scheduled
+        , _source_kind{source}
+        , _isOK{false}, _deb_coll{debug}
 {
 
 }
@@ -23,6 +46,12 @@ cWTimer_::~cWTimer_()
 {
    if (*this)   this->stop() ;                                           // stop Timer, if running
    if (_th.joinable())   _th.join() ;
+#if WTIMER_TRACE
+   _trace_stop.store(true) ;                                             // the records left: consumed first
+   if (_trace_th.joinable())   _trace_th.join() ;
+#endif
+   if (_pool.use_count() == 1)   _pool->stop(), Log_to(0, "\n> dispatched: ", *_pool) ;   // the queued ones are executed
+   _pool.reset() ;                                                       // shared: by the last of its Timers
 
    Log_to(0, "\n> collected information:\n", this->_deb_coll) ;
 }
@@ -34,7 +63,39 @@ void _timer_function(cWTimer_* wt, std::future<void> stop) ;
 bool
 cWTimer_::start()
 {
+   if (_virtual)   return _isOK = true ;                                 // no thread, no workers: see advance()
+   if (!_pool) {                                                         // its workers: by the 1st dispatch, if any
+      auto workers = _pool_workers ? _pool_workers : std::max(2u, std::thread::hardware_concurrency()) - 1 ;
+      try {
+         _pool = std::make_shared<WTimerPool_t>(workers, _pool_capacity, _pool_policy) ;
+      } catch (...) { _pool.reset() ; return false ; }
+   }
+   try { _batch.reserve(_pool_capacity) ; } catch (...) { return false ; }
+   if (!_tickless && !_source) {                                         // ticking: armed here, the 1st tick a period ahead
+      _start_ns = mono_time_ns() ;
+      _source = cWTickSource_::make(_source_kind, _spin.count()) ;
+      if (!_source || !_source->arm(_start_ns, 1000LL * _period.count())) {   // compiled out or, no kernel timer
+         Log_to(0, "> ", _id, ": tick source ", _source_kind, " not available") ;
+         _source.reset() ;
+         return false ;
+      }
+   }
+#if WTIMER_TRACE
+   if (!_trace && (_log_ticks.load() || _trace_sink)) {
+      try {
+         _trace = std::make_unique<cWTimerTraceRing_<WTimerTraceRec_>>(_trace_capacity, _trace_overwrite) ;
+         _trace_th = std::thread(&cWTimer_::trace_consumer, this) ;
+      } catch (...) { _trace.reset() ; }                                 // not traced
+   }
+#endif
    _th = std::thread(std::move(_timer_function), this, this->_sstop.get_future()) ;
+   if (_cpu >= 0) {                                                      // before its first tick: a period ahead
+      cpu_set_t   set ;
+      CPU_ZERO(&set) ;
+      CPU_SET(_cpu, &set) ;
+      if (pthread_setaffinity_np(_th.native_handle(), sizeof(set), &set) != 0)
+         Log_to(0, "> ", _id, ": not pinned to CPU ", _cpu) ;
+   }
    _isOK = true ;                                                        // ie running
    return true ;
 }
@@ -44,30 +105,113 @@ cWTimer_::stop()
 {
    this->_sstop.set_value() ;
    this->_isOK = false ;
+   if (_source)   _source->interrupt() ;                                 // ticking: out of its sleep, if it can
+   { std::lock_guard<std::mutex> lk{_wake_m} ; _woken = true ; }         // tickless: out of its sleep
+   _wake_cv.notify_one() ;
    return ;
 }
 
-                                  // cWTimer_:: operations:: events
+bool
+cWTimer_::reserve(size_t events)                                         // preallocate: no growing while ticking
+{
+   return _events.reserve(events) ;
+}
 
 bool
-cWTimer_::register_event(const cWTimerEvent_& ev, bool fl_cons)          // schedule 'ev', @return - if successful
+cWTimer_::set_tickless(bool on)
 {
-                                                                         // Log_to(0, ": to register const event&: ", ev) ;
-   auto  res = this->calc_request(ev, fl_cons) ;
-   if (!res)   return true ;                                             // ??? should not be (re)scheduled
-   auto [round, tick] = *res ;
-                                                                         /* auto key = _events.make_key(round, tick) ;
-                                                                         // Log_to(0, ": count of key(", round, ", ", tick, "): ",
-                                                                         //           _events.countof(key)) ;*/
-   return _events.add_event(_events.make_key(round, tick), ev) ;
+   if (_th.joinable())   return false ;                                  // already started
+   _tickless = on ;
+   return true ;
 }
 
 bool
-cWTimer_::register_event(cWTimerEvent_&& ev, bool fl_cons)               // schedule 'ev', @return - if successful
+cWTimer_::set_virtual(bool on)
 {
+   if (_th.joinable() || _isOK)   return false ;                         // already started
+   _virtual = on ;
+   return true ;
+}
+
+uint64_t
+cWTimer_::advance(uint64_t ticks)                                        // virtual clock: the caller is the Timer's thread
+{                                                                        // as the tickless one: the empty ticks skipped
+   if (!_virtual || !_isOK)   return 0 ;
+   _tid.store(std::this_thread::get_id()) ;
+
+   auto  fired = _tally._fired ;
+   this->run_to(_events.now() + ticks) ;
+   return _tally._fired - fired ;
+}
+
+bool
+cWTimer_::set_trace(size_t capacity, bool overwrite, std::function<void(const WTimerTraceRec_&)> sink)
+{
+#if WTIMER_TRACE
+   if (_th.joinable() || _isOK)   return false ;                         // already started
+   _trace_capacity = capacity, _trace_overwrite = overwrite, _trace_sink = std::move(sink) ;
+   return true ;
+#else
+   return false ;                                                        // compiled out
+#endif
+}
+
+bool
+cWTimer_::set_overrun(WTOverrun_ policy, uint32_t budget)
+{
+   if (_th.joinable() || _isOK)   return false ;                         // already started
+   _overrun = policy, _budget = policy == WTOverrun_::SPREAD ? budget : 0 ;
+   if (_budget)   _deferred.reserve(4096) ;                              // not to grow while ticking, mostly
+   return true ;
+}
+
+bool
+cWTimer_::set_affinity(int cpu)
+{
+   if (_th.joinable() || cpu >= CPU_SETSIZE)   return false ;            // already started
+   _cpu = cpu ;
+   return true ;
+}
+
+bool
+cWTimer_::set_spin(std::chrono::nanoseconds window)
+{
+   if (_th.joinable() || window.count() < 0)   return false ;           // already started
+   _spin = window ;
+   return true ;
+}
+
+bool
+cWTimer_::set_dispatch(uint32_t workers, size_t capacity, WTBackpressure_ policy)
+{
+   if (_th.joinable() || _isOK)   return false ;                         // already started
+   _pool_workers = workers, _pool_capacity = capacity, _pool_policy = policy ;
+   _pool.reset() ;                                                       // a shared one, if set: not any more
+   return true ;
+}
+
+bool
+cWTimer_::set_pool(std::shared_ptr<WTimerPool_t> pool)
+{
+   if (_th.joinable() || _isOK || !pool)   return false ;                // already started
+   _pool = std::move(pool) ;
+   return true ;
+}
+
+                                  // cWTimer_:: operations:: events
+
+WTimerHandle_
+cWTimer_::register_event(cWTimerEvent_&& ev, bool fl_cons)               // schedule 'ev', @return - its handle
+{
+   if (!this->dispatchable(ev))   return WTimerHandle_{} ;               // see calc_request()
+   if (!this->on_timer_thread()) {                                       // scheduled at the start of the next tick
+      auto h = _events.post_event(std::move(ev)) ;
+      if (_tickless)   this->wake_up() ;
+      return h ;
+   }
                                                                          // Log_to(0, ": to register event&&: ", ev) ;
    auto  res = this->calc_request(ev, fl_cons) ;
-   if (!res)   return true ;                                             // ??? should not be (re)scheduled
+   if (!res)   return WTimerHandle_{} ;                                  // should not be (re)scheduled
    auto [round, tick] = *res ;
                                                                          /* auto key = _events.make_key(round, tick) ;
                                                                          // Log_to(0, ": count of key(", round, ", ", tick, "): ",
@@ -75,103 +219,341 @@ cWTimer_::register_event(cWTimerEvent_&& ev, bool fl_cons)               // sche
    return _events.add_event(_events.make_key(round, tick), std::move(ev)) ;
 }
 
+WTimerHandle_
+cWTimer_::register_event(cWTimerEventsDB_::Node_handle&& nh, bool fl_cons, uint64_t skip) // Timer's thread: relinked
+{
+   if (fl_cons && _events.settled(nh))   return WTimerHandle_{} ;        // cancelled/rescheduled by its call-back
+   auto  res = this->calc_request(nh.mapped(), fl_cons, skip) ;
+   if (!res)   return WTimerHandle_{} ;                                  // a one-time event: nh back to the pool
+   auto [round, tick] = *res ;
+   return _events.add_event(_events.make_key(round, tick), std::move(nh)) ;
+}
+
                                   // cWTimer_:: private ops
 
 std::optional<cWTimer_::Request_coords>                                  // will be Key in cWTimerEventsDB_
-cWTimer_::calc_request(const cWTimerEvent_ &ev, bool fl_cons) &          // depends on the definition of Request_coords
+cWTimer_::calc_request(const cWTimerEvent_ &ev, bool fl_cons, uint64_t skip) & // depends on the definition of Request_coords
 {
    assert(this->_capacity != 0) ;
 
-   auto [ticks, recurr] = ev.in_ticks() ;                                // round, tick, ...
+   auto [period, recurr] = ev.in_ticks() ;                               // round, tick, ...
    if (fl_cons && !recurr)     return std::optional<Request_coords>{} ;
+   if (!this->dispatchable(ev))   return std::optional<Request_coords>{} ;   // would run on the Timer's thread: refused
 
-   ticks += this->_tick ;
-   auto round = this->_rotation + ticks / this->_capacity ;
-   ticks %= this->_capacity ;
+   auto when = (uint64_t)this->_rotation * this->_capacity + this->_tick ;
+   when = ev.aligned(when + (uint64_t)period * (skip + 1)) ;             // skip: periods coalesced, see run_tick()
+   return std::optional<Request_coords>{std::make_pair(when / this->_capacity, (Tick_t)(when % this->_capacity))} ;
+}
 
-   return std::optional<Request_coords>{std::make_pair(round, ticks)} ;
+void
+cWTimer_::drain_posted()                                                 // Timer's thread: at the start of a tick
+{
+   for (auto nh = _events.take_posted() ; nh ; nh = _events.take_posted()) {
+      bool  fired = nh.fired() ;                                         // while queued: as per its period, if any
+      this->register_event(std::move(nh), fired) ;
+   }
+}
+
+void
+cWTimer_::wake_up()                                                      // producers: the lock, if the Timer sleeps only
+{
+   std::atomic_thread_fence(std::memory_order_seq_cst) ;                 // posted: before _idle is read, see sleep_until()
+   if (!_idle.load(std::memory_order_relaxed) || !_idle.exchange(false))   return ;
+   { std::lock_guard<std::mutex> lk{_wake_m} ; _woken = true ; }
+   _wake_cv.notify_one() ;
 }
 
 bool
-cWTimer_::execute(AppCB_&& cb, bool isInlay) { //  assert(cb) ;         // execute, as per policy (isInlay)
+cWTimer_::sleep_until(std::optional<std::chrono::steady_clock::time_point> tp) // nullopt: nothing scheduled
+{
+   std::unique_lock<std::mutex>   lk{_wake_m} ;
+   _idle.store(true, std::memory_order_relaxed) ;
+   std::atomic_thread_fence(std::memory_order_seq_cst) ;                 // either the producer sees _idle or, we - its post
+
+   auto  woken = [this] { return _woken || _events.queued() > 0 ; } ;
+   if (tp)   _wake_cv.wait_until(lk, *tp, woken) ;
+   else      _wake_cv.wait(lk, woken) ;
+
+   _idle.store(false, std::memory_order_relaxed) ;
+   bool  res = woken() ;
+   _woken = false ;
+   return res ;
+}
+
+bool
+cWTimer_::execute(cWTimerEvent_& ev)                                    // execute, as per policy (is_inlay())
+{
+   auto& cb = ev.call_back() ;
+                                                                        // Log_to(0, ": execute Inlay: ", ev.is_inlay(), ", app: ", cb ? true : false) ;
+   if (!cb)            return false ;
+   if (_virtual)       return cb(), true ;                              // virtual clock: in order, on the caller's thread
+   if (_deb_coll.on())   _deb_coll._lateness.record(mono_time_ns() - _due_ns) ;
+   if (ev.is_inlay())  return cb(), true ;                              // in place: no copies, no moves
+
+   if (!ev.in_ticks().second)   _batch.push_back(std::move(cb)) ;       // a one-time: its last use
+   else                         _batch.push_back(cb.clone()) ;          // dispatched at the end of the tick
+   return false ;                                                       // move-only & recurrent: never registered
+}
+
+void
+cWTimer_::dispatch_batch()                                              // one submit per tick
+{
+   if (_batch.empty())   return ;
+   auto  queued = _pool->submit(_batch) ;                               // the workers: started by the 1st one
+   if (_pool->policy() == WTBackpressure_::DROP)   _tally._dropped += _batch.size() - queued ;   // shared: ours only
+   _batch.clear() ;
+}
+
+void
+cWTimer_::run_tick(uint64_t horizon)                                    // the current tick: Timer's thread or, advance()
+{                                                                       // horizon: SKIP_AHEAD's last tick run as one
+   this->drain_posted() ;                                               // registered by other threads since the last tick
+   uint32_t  count = 0 ;
+   for (auto handle = this->event_extract(_rotation, _tick) ; handle ;
+        handle = this->event_extract(_rotation, _tick)) {               // extract all scheduled for {r, t}
+      if (_budget && count == _budget) { _deferred.push_back(std::move(handle)) ; continue ; }   // SPREAD
+      auto&  ev = handle.mapped() ;
+      auto   period = std::max(ev.in_ticks().first, 1u) ;
+      _missed_now = horizon > _events.now() && ev.is_recurrent() ? (horizon - _events.now()) / period : 0 ;
+      this->execute(ev) ;
+      ++_tally._fired, ++count, _tally._coalesced += _missed_now ;
+      if (this->register_event(std::move(handle), true, _missed_now))   ++_tally._rescheduled ;   // Recurrent; otherwise - dropped off
+   }
+   _missed_now = 0 ;
+   if (!_deferred.empty()) {                                            // the next tick: ahead of its own ones
+      ++_tally._over_budget, _tally._deferred += _deferred.size() ;
+      _events.defer(_deferred, _events.now() + 1) ;
+   }
+   this->dispatch_batch() ;                                             // the non-inlay ones: to the workers
+
+   if (++_tick == _capacity) { _tick = 0, ++_rotation ; }               // next {rotation, tick}
+   _events.advance() ;                                                  // ... & cascade, if hierarchical
+}
+
+void
+cWTimer_::run_to(uint64_t end, uint64_t horizon)                        // advance() & SKIP_AHEAD: the ticks up to 'end'
+{
+   while (_events.now() < end) {
+      this->drain_posted() ;                                            // as at the start of a tick: nearer ones, maybe
+      auto  due = std::min(_events.next_due(), end) ;
+      if (due > _events.now())   this->skip_to(due) ;
+      if (due == end)   break ;
+      this->run_tick(horizon) ;
+      ++_tally._ticks ;
+   }
+   this->publish_stats() ;
+}
+
+void
+cWTimer_::skip_to(uint64_t when)                                        // the ticks in between: empty
+{
+   _events.advance_to(when), _tick = when % _capacity, _rotation = when / _capacity ;
+}
 
-                                                                        // Log_to(0, ": execute Inlay: ", isInlay, ", app: ", cb ? true : false) ;
-   if (isInlay)  { if (cb) return  cb(), true ; }
-   // dispatch 'cb' for execution
-   return false ;
+void
+cWTimer_::publish_stats()                                               // a seqlock's writer: plain stores in between
+{
+   _tally._scheduled = _events.size(), _tally._posted = _events.posted(), _tally._max_depth = _events.max_depth() ;
+
+   auto  seq = _stats._seq.load(std::memory_order_relaxed) ;
+   _stats._seq.store(seq + 1, std::memory_order_relaxed) ;
+   std::atomic_thread_fence(std::memory_order_release) ;               // odd: before any of the fields
+   _stats._ticks.store(_tally._ticks, std::memory_order_relaxed) ;
+   _stats._fired.store(_tally._fired, std::memory_order_relaxed) ;
+   _stats._rescheduled.store(_tally._rescheduled, std::memory_order_relaxed) ;
+   _stats._dropped.store(_tally._dropped, std::memory_order_relaxed) ;
+   _stats._missed.store(_tally._missed, std::memory_order_relaxed) ;
+   _stats._scheduled.store(_tally._scheduled, std::memory_order_relaxed) ;
+   _stats._posted.store(_tally._posted, std::memory_order_relaxed) ;
+   _stats._max_depth.store(_tally._max_depth, std::memory_order_relaxed) ;
+   _stats._caught_up.store(_tally._caught_up, std::memory_order_relaxed) ;
+   _stats._skips.store(_tally._skips, std::memory_order_relaxed) ;
+   _stats._coalesced.store(_tally._coalesced, std::memory_order_relaxed) ;
+   _stats._over_budget.store(_tally._over_budget, std::memory_order_relaxed) ;
+   _stats._deferred.store(_tally._deferred, std::memory_order_relaxed) ;
+   _stats._seq.store(seq + 2, std::memory_order_release) ;
+}
+
+void
+cWTimer_::trace_consumer()                                              // polls: the Timer is never held up
+{
+#if WTIMER_TRACE
+   WTimerTraceRec_   r ;
+   for (bool last = false ; !last ; ) {
+      last = _trace_stop.load() ;
+      while (_trace->pop(r))   _trace_sink ? _trace_sink(r) : this->log_trace(r) ;
+      if (!last)   std::this_thread::sleep_for(std::chrono::milliseconds(10)) ;
+   }
+   if (_trace->lost() || _trace->dropped())
+      Log_to(0, "> ", _id, ": trace records lost ", _trace->lost(), ", dropped ", _trace->dropped()) ;
+#endif
+}
+
+void
+cWTimer_::log_trace(const WTimerTraceRec_& r) const&                    // the consumer's default
+{
+   std::ostringstream   skipped ;
+   if (r._tickless)   skipped << ":: skipped:" << r._skipped ;
+   Log_to(0, "\n> ", _id, ": tick<", r._tick / _capacity, ",", r._tick % _capacity, ":period:", _period.count(), "micros>",
+             skipped.str(), ":: jitter_was:", r._jitter_ns / 1000, ":: work_load_Was: ", r._work_ns / 1000,
+             " > deadline: ", r._missed ? "MISSED" : "met", '\n') ;
+}
+
+                                  // cWTimer_:: descriptive
+WTimerStats_
+cWTimer_::stats() const&                                                // a seqlock's reader: retries, never blocks the Timer
+{
+   WTimerStats_   st ;
+   for (auto seq = _stats._seq.load(std::memory_order_acquire) ; ; seq = _stats._seq.load(std::memory_order_acquire)) {
+      if (seq & 1)   continue ;                                         // a publishing in progress: a few stores
+      st._ticks = _stats._ticks.load(std::memory_order_relaxed) ;
+      st._fired = _stats._fired.load(std::memory_order_relaxed) ;
+      st._rescheduled = _stats._rescheduled.load(std::memory_order_relaxed) ;
+      st._dropped = _stats._dropped.load(std::memory_order_relaxed) ;
+      st._missed = _stats._missed.load(std::memory_order_relaxed) ;
+      st._scheduled = _stats._scheduled.load(std::memory_order_relaxed) ;
+      st._posted = _stats._posted.load(std::memory_order_relaxed) ;
+      st._max_depth = _stats._max_depth.load(std::memory_order_relaxed) ;
+      st._caught_up = _stats._caught_up.load(std::memory_order_relaxed) ;
+      st._skips = _stats._skips.load(std::memory_order_relaxed) ;
+      st._coalesced = _stats._coalesced.load(std::memory_order_relaxed) ;
+      st._over_budget = _stats._over_budget.load(std::memory_order_relaxed) ;
+      st._deferred = _stats._deferred.load(std::memory_order_relaxed) ;
+      std::atomic_thread_fence(std::memory_order_acquire) ;             // the fields: before the 2nd read of _seq
+      if (_stats._seq.load(std::memory_order_relaxed) == seq)   return st ;
+   }
+}
+
+std::vector<uint32_t>
+cWTimer_::population() const&                                           // each one exact: not a snapshot of all
+{
+   std::vector<uint32_t>   pop(_events.slots()) ;
+   for (uint32_t s = 0 ; s < pop.size() ; ++s)   pop[s] = _events.depth(s) ;
+   return pop ;
 }
                                   // cWTimer_:: external functions
 
+std::ostream& operator<< (std::ostream& os, const WTimerStats_& st)
+{
+   return os << "stats{ticks:" << st._ticks << ", fired:" << st._fired << ", rescheduled:" << st._rescheduled
+             << ", dropped:" << st._dropped << ", missed:" << st._missed << ", scheduled:" << st._scheduled
+             << ", posted:" << st._posted << ", max depth:" << st._max_depth
+             << ", overruns{caught up:" << st._caught_up << ", skips:" << st._skips << ", coalesced:" << st._coalesced
+             << ", over budget:" << st._over_budget << ", deferred:" << st._deferred << "}}" ;
+}
+
 std::ostream& operator<< (std::ostream& os, const cWTimer_& wt)
 {
-   os << wt._id << "{slots:" << wt._capacity << ", T:" << wt._period
-      << "millis}:" << std::boolalpha << wt._isOK
+   os << wt._id << "{slots:" << wt._capacity << ", levels:" << wt._events.levels() << ", T:" << wt._period.count()
+      << "micros, source:" ;
+   if (wt._tickless)   os << "tickless" ;
+   else                os << wt._source_kind ;
+   os << "}:" << std::boolalpha << wt._isOK
       << " > rotation:" << wt._rotation << ", tick:" << wt._tick ;
-   os << " > # registered events: " << wt._events.size() << wt._events ;
+   os << " > # registered events: " << wt._events.size() << " (+" << wt._events.posted() << " posted)" << wt._events ;
    return os ;
 }
 
 void
-_timer_function(cWTimer_* wt, std::future<void> stop)           // will operate with Events DB - NOT THREAD SAFE yet
+_timer_function(cWTimer_* wt, std::future<void> stop)           // the only one to operate with Events DB directly
 {
    assert(wt && stop.valid()) ;
+   wt->_tid.store(std::this_thread::get_id()) ;                 // register_event(): no posting from this thread
 
-   const auto desired_period = 1000 * wt->_period ;             // in micro-seconds
-   int   avg_jitter = wt->_delay_corr ;                         // compensate for wait_for() delay
-   int   jitter = 0 ;
    auto& deb = wt->_deb_coll ;                                  // to collect info into
 
-   auto& tick = wt->_tick ;                                     // co-ordinates
-   auto& rotation = wt->_rotation ;
-   const auto& capacity = wt->_capacity ;
-
    Log_to(0, "> Timer started at ", LOG_TIME_LAPSE(Log_start())) ;
+   if (wt->_tickless) {                                         // an alternative scheduler
+      wt->tickless_loop(stop) ;
+      stop.get() ;
+      return ;
+   }
 
-   bool     fl_deadline = false ;                               // ::now() - start_tp must be within adjusted period
+   const int64_t   period = 1000LL * wt->_period.count() ;      // in nano-seconds
+   const int64_t   start = wt->_start_ns ;                      // tick N is due at start + (N + 1) * period
+   bool            fl_deadline = false ;                        // the work-load: past the next tick's deadline
+   auto&           source = *wt->_source ;                      // as armed by start(): see wt_tick_source.hpp
 
-   auto start_tp = v_time_now() ; decltype(start_tp) end_tp ;
-   decltype(wt->_period) period = desired_period - avg_jitter ; // compensate delay
-   decltype(period)      work_load_lapse{} ;                    // measure the work-load and take it out from period
+   for (int64_t n = 1 ; ; ++n) {
+      auto  due = start + n * period ;                          // absolute: no drift, no delay to compensate
+      auto  spun = source.wait_until(due) ;                     // at 'due' or later: or, stopped
+      if (stop.wait_for(std::chrono::seconds(0)) == std::future_status::ready)   break ;   // within a tick
 
-   while (stop.wait_for(std::chrono::microseconds(period)) == std::future_status::timeout) {
-      // measuring and adjusting section
-      end_tp = v_time_now(), jitter = (int)(v_time_lapse(end_tp, start_tp) - period) ; // desired_period) ;
-      start_tp = end_tp ;
-      avg_jitter = (avg_jitter + jitter) >> 1 ; // div by 2 meant; // if (jitter > max_jitter)     max_jitter = jitter ;
-      period = desired_period - avg_jitter ;                    // adjust: delays only expected
+      // measuring section
+      auto  woke = mono_time_ns() ;
+      auto  run = wt->_events.now() ;
+      wt->_due_ns = due ;
+      if (woke - due >= period)   ++wt->_tally._caught_up ;     // the previous one(s) overran: back to back
 
       // work-load section, incl internal operations
-                                                                /* Log_to(0, "> currently registered ", wt->_events.size(),
-                                                                          " events: ", wt->_events) ; */
-      for (auto handle = wt->event_extract(rotation, tick) ; handle ;
-           handle = wt->event_extract(rotation, tick)) {        // extract all scheduled for {r, t}
-                                                                // Log_to(0, ": found <", rotation, ", ", tick, ">") ;
-         wt->execute(handle.mapped().call_back(), handle.mapped().is_inlay()) ;
-         wt->register_event(std::move(handle.mapped()), true) ; // to be resheduled if Recurrent; otherwise - dropped off
+      wt->run_tick() ;                                          // posted, due, next {rotation, tick}
+      // measure/check section: the next tick's deadline must be ahead
+      auto  done = mono_time_ns() ;
+
+      if ((fl_deadline = (done > due + period))) {              // @end of Tick: the next one is late already
+         auto  behind = (done - start) / period - n ;           // ... and maybe a few more: >= 1
+         if (wt->_overrun == WTOverrun_::SKIP_AHEAD) {          // as one: each recurrent event fires once at most
+            auto  now = wt->_events.now() ;
+            wt->_due_ns = start + (n + behind) * period ;
+            wt->run_to(now + behind, now + behind - 1) ;
+            ++wt->_tally._skips, n += behind ;
+         }                                                      // CATCH_UP: the deadlines passed, no sleeping
       }
 
-      if (++tick == capacity) { tick = 0, ++rotation ; }        // next {rotation, tick}
-      // measure/check section: ::now() - start_tp must be within adjusted period
-      work_load_lapse = v_time_lapse(v_time_now(), start_tp) ;
-
-      if (fl_deadline = (work_load_lapse > period)) {           // @end of Tick: period MISSED period < desired_period
-         // ??? do something, perhaps
-      } // else period -= work_load_lapse ; // ???  to stay within the required period
-
       // set Debug info
-      deb.insert(cWTimerDebug_::Debug_type{jitter, fl_deadline}) ;
-      // debug: just completed section
-      /**/ Log_to(0, "\n@", LOG_TIME_LAPSE(Log_start()), ": next tick<", rotation, ",", tick,
-                ":period:", period, "micros>",
-                ":: jitter_was:", jitter, ":: avg work_load_Was: ", work_load_lapse,
-                " > debug_size ", deb._coll.size(),
-                " > deadline: ", fl_deadline ? "MISSED" : "met", '\n') ; /**/
+      if (deb.on())   deb.insert(woke - due, done - woke, fl_deadline,
+                                 source.kind() == WTickSource_::HYBRID ? spun : -1) ;
+      ++wt->_tally._ticks, wt->_tally._missed += fl_deadline ;
+      wt->publish_stats() ;
+      // debug: just completed section - formatted by the trace consumer
+      wt->trace(WTimerTraceRec_{run, woke, woke - due, (uint32_t)std::min<int64_t>(done - woke, UINT32_MAX), 0,
+                                fl_deadline, false}) ;
    }
    Log_to(0, "> _timer_function(): quits after", LOG_TIME_LAPSE(Log_start())) ;
 
    stop.get() ;                                                 // just in case
 } // external cWTimer_::_timer_function()
 
+void
+cWTimer_::tickless_loop(std::future<void>& stop)                // tick N is due at t0 + N * period: only the
+{                                                               // non-empty slots (and cascades) are visited
+   using Clock = std::chrono::steady_clock ;
+   const auto   period = _period ;
+   const auto   t0 = Clock::now() + period ;                    // as for ticking: the 1st tick after a period
+
+   for ( ; ; ) {
+      auto  due = _events.next_due() ;                          // _events.now() at least
+      this->sleep_until(due == UINT64_MAX ? std::nullopt : std::optional<Clock::time_point>{t0 + due * period}) ;
+      if (stop.wait_for(std::chrono::seconds(0)) == std::future_status::ready)   break ;
+
+      auto  now_tp = Clock::now() ;                             // steady_clock: CLOCK_MONOTONIC, as mono_time_ns()
+      auto  passed = now_tp < t0 ? 0 : (uint64_t)((now_tp - t0) / period) + 1 ; // # of ticks whose time has come
+      if (passed <= due) {                                      // woken up early: the posted ones, as of the next tick
+         auto  next = std::max(passed, _events.now()) ;
+         if (next > _events.now())   this->skip_to(next) ;
+         this->drain_posted() ;
+         continue ;
+      }
+
+      auto  skipped = due - _events.now() ;
+      if (skipped > 0)   this->skip_to(due) ;
+
+      _due_ns = std::chrono::duration_cast<std::chrono::nanoseconds>((t0 + due * period).time_since_epoch()).count() ;
+      this->run_tick() ;
+
+      auto  work_load = Clock::now() - now_tp ;
+      bool  fl_deadline = work_load > period ;                  // the work-load: longer than a tick
+      auto  woke = std::chrono::duration_cast<std::chrono::nanoseconds>(now_tp.time_since_epoch()).count() ;
+      auto  work_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(work_load).count() ;
+      if (_deb_coll.on())   _deb_coll.insert(woke - _due_ns, work_ns, fl_deadline) ;
+      ++_tally._ticks, _tally._missed += fl_deadline ;
+      this->publish_stats() ;
+      this->trace(WTimerTraceRec_{due, woke, woke - _due_ns, (uint32_t)std::min<int64_t>(work_ns, UINT32_MAX),
+                                  (uint16_t)std::min<uint64_t>(skipped, UINT16_MAX), fl_deadline, true}) ;
+   }
+   Log_to(0, "> _timer_function(): quits after", LOG_TIME_LAPSE(Log_start())) ;
+}
+
                                                                 // eoc cWTimer_
 
 // eof wheel_timer.cpp
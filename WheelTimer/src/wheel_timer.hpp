@@ -1,12 +1,18 @@
 // wheel_timer.hpp: sample implementation of a Periodic Wheel Timer
-//    ( BEST EFFORT: scheduling through sleep_for() / wait_for() compensated for the expected delay )
+//    ( absolute deadlines: tick N is due at start + (N + 1) * period, on CLOCK_MONOTONIC - no drift )
 //                  Requires C++ 17
 //    Basics:
 //    - Timer will run as a separate thread
 //    - class cWTimer_ defined
 //    - two dimensional co-ordinates: round (x ...) x tick (2x for now but could be extended)
 //      NB: an event will be executed at (Round, tick) + Event's period (in ticks)
-//    - events registering is NOT THREAD-SAFE yet
+//    - hierarchical mode (levels > 0): far-future events kept in upper levels, cascaded down lazily
+//    - events registering is thread-safe: other threads post events into a lock-free queue (cWTimerEventsDB_),
+//      drained by the Timer at the start of each tick; the Timer's thread itself schedules them directly
+//    - register_event() @return a handle {node, generation}: cancel() & reschedule() in O(1), from any thread
+//    - tickless mode: the Timer sleeps to the next non-empty slot, woken up earlier by the other threads' events
+//    - tick source: what the Timer sleeps on, chosen at construction - see wt_tick_source.hpp
+//    - high resolution: a period in micros, HYBRID source - sleep, then spin for the last set_spin() of each tick
 //
 
 #ifndef WHEEL_TIMER_HPP
@@ -18,11 +24,19 @@
 #include <utility>
 #include <optional>
 
-#include <map>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <atomic>
+#include <new>
 
 #include <functional>
+#include <type_traits>
+#include <cstddef>
 #include <thread>
 #include <future>
+#include <mutex>
+#include <condition_variable>
 
 // #include <chrono>
 
@@ -33,6 +47,10 @@
 #include "Logger_helpers.hpp"
 
 #include "timing.hpp"                                                    // wrappers around std::chrono
+#include "wt_pool.hpp"                                                   // workers for the dispatched call-backs
+#include "wt_histogram.hpp"                                              // latencies: for debug
+#include "wt_trace.hpp"                                                  // the ticks: traced asynchronously
+#include "wt_tick_source.hpp"                                            // ... their cadence
 
 
 
@@ -45,7 +63,7 @@ struct AppCB_ { // packed with agrs(C-style or not), avoiding gcc -fconcepts-ts
     WTimerCB_return_t operator() () { return _cb(_cb_args, _args_size) ; }
 
   public:
-    AppCB_(WTimerCB_t cb, void* args = nullptr, size_t args_size = 0)
+    AppCB_(WTimerCB_t cb = nullptr, void* args = nullptr, size_t args_size = 0)
           : _cb{cb}, _cb_args{args}, _args_size{args_size} {}
     // all specials  = default (for now):: due to simplicity, opposite to std::function<> - ??? options for concurrent Apps
 
@@ -58,20 +76,113 @@ struct AppCB_ { // packed with agrs(C-style or not), avoiding gcc -fconcepts-ts
     size_t       _args_size{0} ;                                         // ... size of args
 }; // struct AppCB_
 
-class cWTimerEvent_ {    // ??? Move-only
+class AppCallable_ {  // move-only, type-erased call-back: kept in place (no heap), up to INLINE_SIZE bytes of state
+                      //   AppCB_: the fast path - stored as is, called directly (no indirection)
+  public:
+    using return_t = AppCB_::WTimerCB_return_t ;
+    static constexpr size_t   INLINE_SIZE = 48 ;                         // with _ops: 56 bytes, fits a cache line
+
+  private:
+    struct Ops_ {                 // what the erased type knows about itself
+      return_t (* _invoke)(void*) ;
+      void     (* _move)(void* dst, void* src) ;                         // move-construct into dst, destroy src
+      void     (* _destroy)(void*) ;
+      void     (* _clone)(void* dst, const void* src) ;                  // nullptr: not copyable
+    }; // struct Ops_
+
+    template <typename F> static return_t invoke_(void* p)
+             { if constexpr (std::is_convertible_v<std::invoke_result_t<F&>, return_t>) return (*static_cast<F*>(p))() ;
+               else { (*static_cast<F*>(p))() ; return nullptr ; } }
+    template <typename F> static void move_(void* d, void* s)
+             { ::new (d) F(std::move(*static_cast<F*>(s))), static_cast<F*>(s)->~F() ; }
+    template <typename F> static void destroy_(void* p) { static_cast<F*>(p)->~F() ; }
+    template <typename F> static void clone_(void* d, const void* s) { ::new (d) F(*static_cast<const F*>(s)) ; }
+
+    template <typename F> static constexpr void (* clone_of())(void*, const void*)   // move-only: not instantiated
+             { if constexpr (std::is_copy_constructible_v<F>) return &clone_<F> ; else return nullptr ; }
+    template <typename F> static const Ops_* ops_of()
+             { static constexpr Ops_ ops{ &invoke_<F>, &move_<F>, &destroy_<F>, clone_of<F>() } ;
+               return &ops ; }
+
+  public:
+                                  // constructors & destructor
+    AppCallable_() noexcept { ::new (_buf) AppCB_{} ; }
+    AppCallable_(const AppCB_& cb) noexcept { ::new (_buf) AppCB_{cb} ; }
+    AppCallable_(WTimerCB_t cb, void* args = nullptr, size_t args_size = 0) noexcept
+                { ::new (_buf) AppCB_{cb, args, args_size} ; }
+
+    template <typename F, typename D = std::decay_t<F>,                  // lambdas, functors, ...: F() is to be valid
+              typename = std::enable_if_t<!std::is_same_v<D, AppCallable_> && !std::is_same_v<D, AppCB_>
+                                          && std::is_invocable_v<D&>>>
+    AppCallable_(F&& f) : _ops{ops_of<D>()}
+    {
+       static_assert(sizeof(D) <= INLINE_SIZE && alignof(D) <= alignof(std::max_align_t),
+                     "AppCallable_: the call-back's state does not fit in place") ;
+       static_assert(std::is_nothrow_move_constructible_v<D>, "AppCallable_: the call-back must be nothrow movable") ;
+       ::new (_buf) D(std::forward<F>(f)) ;
+    }
+
+    AppCallable_(AppCallable_&& c) noexcept : _ops{c._ops} { this->take(c) ; }
+    AppCallable_& operator= (AppCallable_&& c) noexcept
+                  { if (this != &c) { this->reset() ; _ops = c._ops, this->take(c) ; } return *this ; }
+    AppCallable_(const AppCallable_&) = delete ;
+    AppCallable_& operator= (const AppCallable_&) = delete ;
+    ~AppCallable_() { this->reset() ; }
+
+                                  // operations
+    return_t operator() () { return _ops ? _ops->_invoke(_buf) : this->app()() ; }
+
+    bool         clonable() const& { return !_ops || _ops->_clone ; }
+    AppCallable_ clone() const& ;                                        // in place, as well; empty: if not clonable
+
+                                  // descriptive
+    explicit operator bool() const& { return _ops || this->app() ; }     // if a Valid call-back
+
+  private:
+    AppCB_&       app() &       { return *std::launder(reinterpret_cast<AppCB_*>(_buf)) ; }
+    const AppCB_& app() const&  { return *std::launder(reinterpret_cast<const AppCB_*>(_buf)) ; }
+
+    void take(AppCallable_& c) noexcept                                  // _ops: set already; c: left empty
+         { if (_ops) _ops->_move(_buf, c._buf) ; else ::new (_buf) AppCB_{c.app()} ;
+           c._ops = nullptr, ::new (c._buf) AppCB_{} ; }
+    void reset() noexcept { if (_ops) _ops->_destroy(_buf), _ops = nullptr, ::new (_buf) AppCB_{} ; }
+
+    alignas(std::max_align_t) unsigned char   _buf[INLINE_SIZE] ;        // AppCB_ unless _ops
+    const Ops_*                               _ops{nullptr} ;
+}; // class AppCallable_
+
+inline AppCallable_
+AppCallable_::clone() const&
+{
+   AppCallable_   c{} ;
+   if (!_ops)                ::new (c._buf) AppCB_{this->app()} ;
+   else if (_ops->_clone)    _ops->_clone(c._buf, _buf), c._ops = _ops ;
+   return c ;
+}
+
+class cWTimerEvent_ {    // Move-only: see AppCallable_
+                         //   its call-back, as executed: inlay (or, a virtual clock) - the same one, in place, each
+                         //   firing; dispatched & one-time - moved to a worker; dispatched & recurrent - a copy of it
+                         //   as registered per firing: its state not carried over (to be shared by pointer), move-only
+                         //   ones refused by register_event()
 
   public:
                                   // constructors & destructor
     cWTimerEvent_(uint32_t period_in_ticks, bool isRecurrent = false,
-                  const AppCB_& func = AppCB_{nullptr}, bool isInlay = false) ;
-    // all specials  = default ;
+                  AppCallable_&& func = AppCallable_{}, bool isInlay = false,
+                  uint32_t slack_in_ticks = 0) ;                          // due in [period, period + slack]
+    cWTimerEvent_(cWTimerEvent_&&) = default ;
+    cWTimerEvent_& operator= (cWTimerEvent_&&) = default ;
 
                                   // operations
     decltype(auto) in_ticks() const& { return std::make_pair(_wt_ticks, _is_recurrent) ; }
 
     bool           is_recurrent() const& { return _is_recurrent ; }
     bool           is_inlay()     const& { return _inlay ; }
-    AppCB_         call_back()    const& { return _cb ; }
+    uint32_t       slack()        const& { return _slack ; }
+    uint64_t       aligned(uint64_t when) const& ;                       // due tick: the roundest one within slack
+    AppCallable_&  call_back()    &      { return _cb ; }
+    const AppCallable_& call_back() const& { return _cb ; }
 
                                   // helpers
     friend std::ostream& operator<< (std::ostream& os, const cWTimerEvent_& wt) ;
@@ -81,29 +192,117 @@ class cWTimerEvent_ {    // ??? Move-only
     uint32_t   _wt_ticks{0} ;                                            // period in Sequencer's ticks
     bool       _is_recurrent{false} ;                                    // periodic or one-time event
 
-    AppCB_     _cb ;                                                     // to be executed
+    AppCallable_   _cb ;                                                 // to be executed
     bool       _inlay{false} ;                                           // call _cb immediately or dispatch it
+    uint32_t   _slack{0} ;                                               // ticks it may be late by: coalesced
 }; // class cWTimerEvent_: still a mark only
 
+inline uint64_t
+cWTimerEvent_::aligned(uint64_t when) const&                             // as Linux' timer slack: unrelated events
+{                                                                        // ... meet on the same aligned ticks
+   if (!_slack)   return when ;
+   auto  limit = when + _slack ;
+   auto  bit = 63 - __builtin_clzll(when ^ limit) ;                      // the highest one they differ in
+   return limit & ~((1ULL << bit) - 1) ;                                 // the most trailing zeros in [when, limit]
+}
+
 
-class cWTimerEventsDB_ {          // Storage and access to scheduled Events
+struct WTimerHandle_ {            // a scheduled event: {node in cWTimerEventsDB_, its generation}: cancel(), reschedule()
+  uint32_t   _ix{UINT32_MAX} ;
+  uint32_t   _gen{0} ;                                                   // stale, once the node is back to the pool
 
-  using Key = std::pair<uint32_t, uint32_t> ;                            // Tick coords: execute it at: 1st is 0, 2nd is Current
+  explicit operator bool() const& { return _ix != UINT32_MAX ; }         // if registered
+  bool operator== (const WTimerHandle_& h) const& { return _ix == h._ix && _gen == h._gen ; }
+}; // struct WTimerHandle_
+
+
+class cWTimerEventsDB_ {          // Storage and access to scheduled Events: a slot array of intrusive lists
+                                  //   levels == 0: flat wheel: a slot holds the events of all rotations for its tick
+                                  //   levels > 0 : hierarchical: level 0 holds the current rotation only; upper levels
+                                  //                of LEVEL_SLOTS slots each, cascaded down lazily (see advance())
+  public:
+  using Key = std::pair<uint64_t, uint32_t> ;                            // Tick coords: {rotation, tick}
   using Value = cWTimerEvent_ ;
-  using Collection = std::multimap<Key, Value> ;                         // the Container: ??? Hash table
-  using ConstIterator = Collection::const_iterator ;
-  using Iterator = Collection::iterator ;
-  using Element_type = Collection::value_type ;
 
   private:
+  using Index_t = uint32_t ;                                             // links: indices into the pool of nodes
+
+  static constexpr Index_t   NIL = UINT32_MAX ;                          // 'no node'
+  static constexpr uint32_t  CHUNK_SHIFT = 10 ;                          // the pool grows by chunks of 1 << CHUNK_SHIFT nodes
+  static constexpr uint32_t  CHUNK_MASK = (1u << CHUNK_SHIFT) - 1 ;
+  static constexpr uint32_t  MAX_CHUNKS = 1u << 14 ;                     // ... up to 16M nodes
+  static constexpr size_t    CACHE_LINE = 64 ;
+
+                                  // Node_::_ctl: {generation:24, flags:8, ticks:32}: requests from any thread
+  static constexpr uint32_t  GEN_SHIFT = 40 ;
+  static constexpr uint64_t  TICKS_MASK = UINT32_MAX ;
+  static constexpr uint64_t  F_QUEUED  = 1ull << 32 ;                    // in the queue of posted: the owner decides
+  static constexpr uint64_t  F_CANCEL  = 2ull << 32 ;
+  static constexpr uint64_t  F_RESCHED = 4ull << 32 ;                    // ... to 'ticks' from the current tick
+  static constexpr uint64_t  F_ALL     = F_QUEUED | F_CANCEL | F_RESCHED ;
+
+  enum class Where_ : uint8_t { NEW, LINKED, DETACHED } ;                // DETACHED: extracted, not back to the pool
+
+  public:
+  static constexpr uint32_t  LEVEL_SLOTS = 64 ;                          // slots of an upper level
+  static constexpr uint32_t  MAX_LEVELS = 4 ;                            // # of upper levels: hierarchical mode
+
+  private:
+
+  struct Node_ {                  // an element of the pool: linked into its slot or, into the free list
+    uint64_t               _when{0} ;                                    // absolute tick: rotation * _capacity + tick
+    std::optional<Value>   _ev{} ;                                       // engaged while in a slot
+    uint32_t               _slot{0} ;                                    // where linked: index into _slots
+    Index_t                _prev{NIL} ;                                  // slot links: Timer's thread only
+    Index_t                _next{NIL} ;
+    Where_                 _where{Where_::NEW} ;
+    std::atomic<Index_t>   _qnext{NIL} ;                                 // the free list or, the queue of posted
+    std::atomic<uint64_t>  _ctl{0} ;                                     // see F_xxx
+  }; // struct Node_
+
+  struct Slot_ {                  // intrusive list of the events scheduled for a tick
+    Index_t                 _head{NIL} ;
+    Index_t                 _tail{NIL} ;
+    std::atomic<uint32_t>   _count{0} ;                                  // # linked: Timer's thread writes, any reads
+
+    Slot_() = default ;
+    Slot_(const Slot_& s) : _head{s._head}, _tail{s._tail}, _count{s._count.load(std::memory_order_relaxed)} {}
+    Slot_& operator= (const Slot_& s)
+           { _head = s._head, _tail = s._tail, _count.store(s._count.load(std::memory_order_relaxed), std::memory_order_relaxed) ;
+             return *this ; }
+    uint32_t add(uint32_t n)                                             // a single writer: no RMW; n: may wrap (-1)
+             { auto c = _count.load(std::memory_order_relaxed) + n ; _count.store(c, std::memory_order_relaxed) ; return c ; }
+  }; // struct Slot_
+
+  public:
+    class Node_handle {           // like std::multimap<>::node_type: owns an extracted node; returns it to the pool
+      public:
+        Node_handle() = default ;
+        Node_handle(Node_handle&& nh) noexcept : _db{nh._db}, _ix{nh._ix} { nh._db = nullptr ; }
+        Node_handle& operator= (Node_handle&& nh) noexcept
+                     { if (this != &nh) { this->release() ; _db = nh._db, _ix = nh._ix, nh._db = nullptr ; } return *this ; }
+        ~Node_handle() { this->release() ; }
+
+        explicit operator bool() const& { return _db != nullptr ; }
+        Key        key() const&    { assert(_db) ; return _db->key_of(_db->node(_ix)._when) ; }
+        Value&     mapped() const& { assert(_db) ; return *(_db->node(_ix)._ev) ; }
+        bool       fired() const&  { assert(_db) ; return _db->node(_ix)._where == Where_::DETACHED ; }
+
+      private:
+        friend class cWTimerEventsDB_ ;
+        Node_handle(cWTimerEventsDB_* db, Index_t ix) : _db{db}, _ix{ix} {}
+        void release() { if (_db) _db->release_node(_ix), _db = nullptr ; }
+
+        cWTimerEventsDB_*   _db{nullptr} ;
+        Index_t             _ix{NIL} ;
+    }; // class Node_handle
 
   public:
                                   // constructors & destructor
-    // explicit cWTimerEventsDB_() : _ticks_in_round{0}, _events{}, _sth{} {}
-    explicit cWTimerEventsDB_() : _events{}, _sth{} {}
-    cWTimerEventsDB_(cWTimerEventsDB_&&) = default ;
-    cWTimerEventsDB_& operator= (cWTimerEventsDB_&&) = default ;
-    ~cWTimerEventsDB_() { if (_sth.joinable()) _sth.join() ; }
+    explicit cWTimerEventsDB_(uint32_t slots, uint32_t levels = 0) ;
+    cWTimerEventsDB_(const cWTimerEventsDB_&) = delete ;                 // the pool is shared with producers
+    cWTimerEventsDB_& operator= (const cWTimerEventsDB_&) = delete ;
+    ~cWTimerEventsDB_() ;
 
                                   // operations
     template <typename ... Args> Key make_key(Args... args) { // prepare & return a Key
@@ -112,83 +311,361 @@ class cWTimerEventsDB_ {          // Storage and access to scheduled Events
                 return std::make_pair(std::get<0>(t), std::get<1>(t)) ; // the current design of Key
              }
 
-    template <typename ... Args> decltype(auto) extract(Args... args)   // prepare & return a Node; see make_key()
-             { return _events.extract(this->make_key(std::forward<Args>(args)...)) ; }
+    template <typename ... Args> Node_handle extract(Args... args)      // prepare & return a Node; see make_key()
+             { return this->extract_key(this->make_key(std::forward<Args>(args)...)) ; }
+
+    WTimerHandle_ add_event(Key&& k, Value&& v) ;                        // Value: move-only
+    WTimerHandle_ add_event(const Key& k, Node_handle&& nh) ;            // (re)link an extracted node: no copies
+    bool          settled(Node_handle& nh) ;                             // a fired one: cancelled/rescheduled meanwhile
+    void          defer(std::vector<Node_handle>& nhs, uint64_t when) ;  // extracted, not fired: first at 'when', in order
 
-    bool add_event(const Key& k, const Value& v) ;
-    bool add_event(Key&& k, Value&& v) ;
+    template <typename It, typename KeyOf>                               // KeyOf: const Value& -> std::optional<Key>
+    size_t add_events(It first, It last, KeyOf key_of,                   // Values moved from; a splice per slot
+                      std::vector<WTimerHandle_>& hs) ;                  // ... @return # added: all or, none
+
+                                  // operations: thread-safe, lock-free
+    WTimerHandle_ post_event(Value&& v) ;                                // to be scheduled by the owner (take_posted())
+    template <typename It, typename Accept>                              // Accept: const Value& -> bool
+    size_t        post_events(It first, It last, Accept accept,          // ... one push: visible all at once
+                              std::vector<WTimerHandle_>& hs) ;          // ... not accepted: an empty handle; @return
+                                                                         // ... # posted - out of memory: 0, hs as was
+    Node_handle   take_posted() ;                                        // owner (Timer's thread) only: one consumer
+
+    bool cancel(const WTimerHandle_& h, bool owner) ;                    // O(1); owner: called on Timer's thread
+    bool reschedule(const WTimerHandle_& h, uint32_t ticks, bool owner) ; // ... 'ticks' from the current tick
+
+    void advance() ;                                                     // next tick: cascades upper levels, if due
+    void advance_to(uint64_t when) ;                                     // ... to 'when' <= next_due() in one step
+    uint64_t next_due() const& ;                                         // the nearest tick with a non-empty slot
+                                                                         // (or, a cascade); UINT64_MAX: none
+    bool reserve(size_t n) ;                                             // the pool: n nodes at least; thread-safe
 
                                   // descriptive
-    size_t size() const& { return _events.size() ; }
-    size_t countof(const Key& k) const& { return _events.count(k) ; }
+    size_t size() const& { return _size ; }
+    size_t posted() const& { return _posted.load(std::memory_order_relaxed) ; }   // registrations: not taken yet
+    size_t queued() const& { return _queued.load(std::memory_order_relaxed) ; }   // ... & cancel/reschedule requests
+    size_t capacity() const& { return (size_t)std::min(_nchunks.load(std::memory_order_relaxed), MAX_CHUNKS) << CHUNK_SHIFT ; }
+    size_t countof(const Key& k) const& ;
+    uint32_t levels() const& { return _levels ; }
+    uint64_t now() const& { return _now ; }                              // the current absolute tick
+    uint32_t slots() const& { return (uint32_t)_slots.size() ; }         // all levels
+    uint32_t depth(uint32_t slot) const&                                 // # linked in 'slot': any thread
+             { return _slots[slot]._count.load(std::memory_order_relaxed) ; }
+    uint32_t max_depth() const& { return _max_depth ; }                  // the deepest a slot has been: Timer's thread
 
                                   // helpers
     friend std::ostream& operator<< (std::ostream& os, const cWTimerEventsDB_& wt) ;
-    friend std::ostream& operator<< (std::ostream& os, const Iterator& it) ;
+    friend std::ostream& operator<< (std::ostream& os, const Node_handle& nh) ;
 
   private:
+                                  // the pool of nodes: lock-free free list (tagged against ABA)
+    Node_&       node(Index_t ix) &
+                 { return _chunks[ix >> CHUNK_SHIFT].load(std::memory_order_acquire)[ix & CHUNK_MASK] ; }
+    const Node_& node(Index_t ix) const&
+                 { return _chunks[ix >> CHUNK_SHIFT].load(std::memory_order_acquire)[ix & CHUNK_MASK] ; }
+    Index_t      alloc_node() ;                                          // may throw (a new chunk)
+    void         alloc_nodes(size_t n, std::vector<Index_t>& ixs) ;      // ... a few at a time off the free list
+    Index_t      alloc_fresh(size_t n) ;                                 // ... never used ones: [@return, + n)
+    Node_*       make_chunk(uint32_t c) ;                                // on demand: concurrent makers, one wins
+    void         free_node(Index_t ix) ;
+    void         release_node(Index_t ix) ;                              // next generation & free, unless queued
+    void         push_free(Index_t first, Index_t last) ;                // a chain linked through _qnext
+    void         push_posted(Index_t ix) { this->push_posted(ix, ix, ix != _qstub) ; }
+    void         push_posted(Index_t first, Index_t last, size_t n) ;    // a chain linked through _qnext: n events
+    Index_t      pop_posted() ;
+    Node_*       node_of(const WTimerHandle_& h) ;                       // nullptr: not a node
+    WTimerHandle_ handle_of(Index_t ix) const&
+                 { return WTimerHandle_{ix, (uint32_t)(this->node(ix)._ctl.load(std::memory_order_relaxed) >> GEN_SHIFT)} ; }
+
+                                  // slots: O(1) link/unlink
+    uint64_t     when_of(const Key& k) const& { return k.first * _capacity + k.second ; }
+    Key          key_of(uint64_t when) const& { return Key{when / _capacity, (uint32_t)(when % _capacity)} ; }
+    uint32_t     slot_of(uint64_t when) const& ;                         // placement as per _now
+    void         link(Index_t ix, bool front = false) ;                  // at the tail (head) of the slot of node(ix)._when
+    void         unlink(Index_t ix) ;
+    void         splice(uint32_t slot, const Slot_& chain) ;             // at the tail of 'slot': linked through _next
+    void         cascade(uint32_t level) ;                               // re-place the current slot of 'level'
+    size_t       count_in(uint32_t slot, uint64_t when) const& ;
+    uint32_t     occupied(uint32_t from, uint32_t to) const& ;           // the 1st non-empty slot in [from, to): or, 'to'
+    Node_handle  extract_key(const Key& k) ;                             // the head of the slot of 'k', if due
+    void         gather(uint32_t slot, uint64_t when) ;                  // ... the due ones to its head: a pass per tick
+
+    uint32_t                                 _capacity{0} ;              // level 0: # of ticks of a rotation
+    uint32_t                                 _levels{0} ;                // # of upper levels: 0 - flat wheel
+    uint64_t                                 _gran[MAX_LEVELS + 1]{} ;   // ticks covered by a slot of a level
+    uint64_t                                 _now{0} ;                   // the current absolute tick
+
+    std::vector<Slot_>                       _slots{} ;                  // _capacity + _levels * LEVEL_SLOTS
+    std::vector<uint64_t>                    _occupancy{} ;              // a bit per slot: if non-empty
+    std::vector<Slot_>                       _bulk{} ;                   // add_events(): a chain per slot, then spliced
+    size_t                                   _size{0} ;                  // # of scheduled events
+    uint32_t                                 _max_depth{0} ;             // see max_depth()
+    uint64_t                                 _gathered{UINT64_MAX} ;     // the tick whose due ones lead its slot
+
+    std::unique_ptr<std::atomic<Node_*>[]>   _chunks ;                   // the pool: MAX_CHUNKS, nodes never move
+    std::atomic<uint32_t>                    _nchunks{0} ;              // chunks [0, _nchunks): made, or being made
+    alignas(CACHE_LINE) std::atomic<uint64_t>  _fresh{0} ;               // the never used nodes: [_fresh, ...)
+    alignas(CACHE_LINE) std::atomic<uint64_t>  _free{NIL} ;              // {tag, index} of the free list's head
+
+    alignas(CACHE_LINE) std::atomic<Index_t>   _qhead{NIL} ;             // posted: intrusive MPSC queue - producers
+    alignas(CACHE_LINE) Index_t                _qtail{NIL} ;             // ... the consumer
+    Index_t                                    _qstub{NIL} ;
+    std::atomic<size_t>                        _queued{0} ;              // records in the queue: all of them
+    std::atomic<size_t>                        _posted{0} ;              // ... Where_::NEW ones: see posted()
 
-    // uint32_t      _ticks_in_round{0} ;                                   // # of ticks in a round: two levels only
-    Collection    _events{} ;                                            // for all scheduled events
     std::thread   _sth{} ;                                               // ??? the Managing thread
 }; // class cWTimerEventsDB_
 
-
-struct cWTimerDebug_ {            // store and output debug info, like measurements, etc
-   using Jitter_type = int ;
-   using Debug_type = std::pair<Jitter_type, bool> ;   // jitter x (if adjusted period met)
-
+                                  // cWTimerEventsDB_:: bulk operations
+template <typename It, typename KeyOf>
+size_t
+cWTimerEventsDB_::add_events(It first, It last, KeyOf key_of, std::vector<WTimerHandle_>& hs)
+{
+   std::vector<Index_t>    ixs ;
+   std::vector<uint32_t>   touched ;                                     // slots with a chain in _bulk
+   try {
+      auto n = (size_t)std::distance(first, last) ;
+      hs.reserve(hs.size() + n), ixs.reserve(n), touched.reserve(std::min(n, _slots.size())) ;
+      _bulk.resize(_slots.size()) ;
+      this->alloc_nodes(n, ixs) ;
+   } catch (...) {                                                       // none of them
+      for (auto ix : ixs)   this->free_node(ix) ;
+      return 0 ;
+   }
+
+   size_t   added = 0 ;
+   for (auto it = first ; it != last ; ++it) {                           // one pass: the keys, chains per slot
+      auto  k = key_of(*it) ;
+      if (!k) { hs.emplace_back() ; continue ; }
+
+      auto  ix = ixs[added++] ;
+      auto& n = this->node(ix) ;
+      n._ev.emplace(std::move(*it)) ;
+      n._when = this->when_of(*k), n._slot = this->slot_of(n._when), n._where = Where_::LINKED, n._next = NIL ;
+
+      auto& b = _bulk[n._slot] ;
+      b.add(1) ;
+      if (b._head == NIL)   touched.push_back(n._slot), b._head = ix, n._prev = NIL ;
+      else                  this->node(b._tail)._next = ix, n._prev = b._tail ;
+      b._tail = ix ;
+      hs.push_back(this->handle_of(ix)) ;
+   }
+   for (auto i = added ; i < ixs.size() ; ++i)   this->free_node(ixs[i]) ;   // not to be scheduled
+
+   for (auto s : touched)   this->splice(s, _bulk[s]), _bulk[s] = Slot_{} ;
+   _size += added ;
+   return added ;
+}
+
+template <typename It, typename Accept>
+size_t
+cWTimerEventsDB_::post_events(It first, It last, Accept accept, std::vector<WTimerHandle_>& hs)
+{
+   constexpr size_t       AT_ONCE = 256 ;                                // nodes filled while still in the cache
+   std::vector<Index_t>   ixs ;
+   std::vector<It>        taken ;                                        // the accepted ones, in order
+   size_t                 filled = 0 ;
+   try {
+      for (auto it = first ; it != last ; ++it)   if (accept(*it))   taken.push_back(it) ;
+      hs.reserve(hs.size() + (size_t)std::distance(first, last)), ixs.reserve(taken.size()) ;
+
+      for (Index_t prev = NIL ; filled < taken.size() ; ) {
+         this->alloc_nodes(std::min(taken.size(), filled + AT_ONCE), ixs) ;
+         for ( ; filled < ixs.size() ; ++filled) {                       // not published yet: plain stores will do
+            auto& nd = this->node(ixs[filled]) ;
+            nd._ev.emplace(std::move(*taken[filled])) ;
+            nd._where = Where_::NEW ;
+            nd._ctl.store(nd._ctl.load(std::memory_order_relaxed) | F_QUEUED, std::memory_order_relaxed) ;
+            if (prev != NIL)   this->node(prev)._qnext.store(ixs[filled], std::memory_order_relaxed) ;
+            prev = ixs[filled] ;
+         }
+      }
+   } catch (...) {                                                       // none of them: back to where they were
+      for (size_t i = 0 ; i < filled ; ++i)   *taken[i] = std::move(*this->node(ixs[i])._ev) ;
+      for (auto ix : ixs) {                                              // F_QUEUED: the next owner's add_event() to link it
+         auto& nd = this->node(ix) ;
+         nd._ctl.store(nd._ctl.load(std::memory_order_relaxed) & ~F_QUEUED, std::memory_order_relaxed) ;
+         this->free_node(ix) ;
+      }
+      return 0 ;
+   }
+
+   size_t   k = 0 ;
+   for (auto it = first ; it != last ; ++it)
+      hs.push_back(k < taken.size() && taken[k] == it ? this->handle_of(ixs[k++]) : WTimerHandle_{}) ;
+   if (ixs.empty())   return 0 ;
+   _posted.fetch_add(ixs.size(), std::memory_order_relaxed) ;
+   this->push_posted(ixs.front(), ixs.back(), ixs.size()) ;              // the release: all the above
+   return ixs.size() ;
+}
+
+
+struct cWTimerDebug_ {            // store and output debug info: latency histograms, in nanos - fixed memory
    public:
-     explicit cWTimerDebug_(size_t cap = 0, uint32_t ticks = 0) ;
-     template <typename T>
-     void insert(T&& el) { if (_coll.size() < _coll.capacity()) _coll.emplace_back(std::forward<T>(el)) ; }
+     explicit cWTimerDebug_(bool on = false) : _on{on} {}
+
+     bool on() const& { return _on ; }
+     void insert(int64_t jitter, int64_t work_load, bool missed,         // a tick's: by the Timer's thread
+                 int64_t spun = -1)                                      // ... HYBRID: busy-waited for
+          { _jitter.record(jitter), _work_load.record(work_load) ;
+            if (spun >= 0)   _spin.record(spun) ;
+            if (missed)   _missed.fetch_add(1, std::memory_order_relaxed) ; }
+     void reset() & { _jitter.reset(), _work_load.reset(), _lateness.reset(), _spin.reset(), _missed.store(0, std::memory_order_relaxed) ; }
 
      friend std::ostream& operator<< (std::ostream& os, const cWTimerDebug_& wtd) ;
 
    public:
-     std::vector<Debug_type>   _coll{} ;
-     uint32_t                  _tir{} ;                                  // cosmetics targetted
+     cWTimerHistogram_       _jitter{} ;                                 // a tick: woken up late by
+     cWTimerHistogram_       _work_load{} ;                              // ... its work: took
+     cWTimerHistogram_       _lateness{} ;                               // a call-back: run or dispatched, late by
+     cWTimerHistogram_       _spin{} ;                                   // a tick: spun for, HYBRID - the price of _jitter
+     std::atomic<uint64_t>   _missed{0} ;                                // ticks: past the next one's deadline
+     bool                    _on{false} ;
 }; // struct cWTimerDebug_
 
 
+struct WTimerStats_ {             // cWTimer_::stats(): as of the end of a tick, all the fields of the same one
+  uint64_t   _ticks{0} ;                                                 // processed (tickless: visited)
+  uint64_t   _fired{0} ;                                                 // call-backs run or dispatched
+  uint64_t   _rescheduled{0} ;                                           // recurrent ones: re-armed after firing
+  uint64_t   _dropped{0} ;                                               // dispatched ones: dropped by back-pressure
+  uint64_t   _missed{0} ;                                                // ticks: past the next one's deadline
+  uint64_t   _scheduled{0} ;                                             // population: in the slots
+  uint64_t   _posted{0} ;                                                // ... registered by other threads, not drained
+  uint64_t   _max_depth{0} ;                                             // the deepest slot, so far
+                                  // overruns: see WTOverrun_
+  uint64_t   _caught_up{0} ;                                             // ticks run a period late or more: back to back
+  uint64_t   _skips{0} ;                                                 // SKIP_AHEAD: late ticks run as one
+  uint64_t   _coalesced{0} ;                                             // ... recurrent firings folded into one
+  uint64_t   _over_budget{0} ;                                           // SPREAD: ticks with more due than the budget
+  uint64_t   _deferred{0} ;                                              // ... expirations moved to the next tick
+
+  friend std::ostream& operator<< (std::ostream& os, const WTimerStats_& st) ;
+}; // struct WTimerStats_
+
+enum class WTOverrun_ { CATCH_UP,                                        // the late ticks: run back to back
+                        SKIP_AHEAD,                                      // ... as one: a recurrent event fires once,
+                                                                         //     the misses told by cWTimer_::missed()
+                        SPREAD                                           // call-backs per tick: a budget at most,
+                      } ;                                                //     the rest deferred to the next tick
+
+
+using WTimerPool_t = cWTimerPool_<AppCallable_> ;
+
 class cWTimer_ { // not a template as to have the possibility of changing characteristics in run-time
-  using Rotation_t = uint32_t ;
+  using Rotation_t = uint64_t ;                                          // does not wrap for a process' life-time
   using Tick_t = uint32_t ;
   using Request_coords = std::pair<Rotation_t, Tick_t> ;
 
+  struct alignas(64) Published_ { // WTimerStats_ as a seqlock: the Timer's thread writes once per tick, no RMW
+    std::atomic<uint64_t>   _seq{0} ;                                    // odd: being written
+    std::atomic<uint64_t>   _ticks{0}, _fired{0}, _rescheduled{0}, _dropped{0},
+                            _missed{0}, _scheduled{0}, _posted{0}, _max_depth{0},
+                            _caught_up{0}, _skips{0}, _coalesced{0}, _over_budget{0}, _deferred{0} ;
+  }; // struct Published_
+
   private:
                                   // operations
     std::optional<Request_coords> calc_request(const cWTimerEvent_& ev,  // ev would be scheduled for (rotation, tick)
-                                               bool fl_cons = false) & ; // 1st call: ignore _is_recurrent flag
+                                               bool fl_cons = false,     // 1st call: ignore _is_recurrent flag
+                                               uint64_t skip = 0) & ;    // ... periods skipped: coalesced firings
 
     decltype(auto) event_extract(Rotation_t r, Tick_t t) &               // @return the extracted with Key{r, t}
                    { return this->_events.extract(r, t) ; }
 
-    bool execute(AppCB_&& cb, bool isInlay) ;                            // cb is to be executed or send for execution
+    bool dispatchable(const cWTimerEvent_& ev) const&                    // recurrent & dispatched: a copy per firing,
+                                                                         // ... see cWTimerEvent_
+         { return _virtual || ev.is_inlay() || !ev.is_recurrent() || ev.call_back().clonable() ; }
+    bool execute(cWTimerEvent_& ev) ;                                    // its call-back is executed or sent for execution
+    void dispatch_batch() ;                                              // the tick's non-inlay ones: to the workers
+
+    bool on_timer_thread() const&                                        // if so, _events is accessed directly
+         { return _tid.load(std::memory_order_relaxed) == std::this_thread::get_id() ; }
+    void drain_posted() ;                                                // schedule events posted by other threads
+    void wake_up() ;                                                     // tickless: a nearer event, maybe
+    bool sleep_until(std::optional<std::chrono::steady_clock::time_point> tp) ; // ... @return if woken up
+    void tickless_loop(std::future<void>& stop) ;                        // _timer_function() in tickless mode
+    void publish_stats() ;                                               // _tally: to _stats, at the end of a tick
+    void run_tick(uint64_t horizon = 0) ;                                // drain, fire the due ones, move on
+    void run_to(uint64_t end, uint64_t horizon = 0) ;                    // ... up to 'end': the empty ones skipped
+    void skip_to(uint64_t when) ;                                        // ... to 'when': no due ones in between
+    void trace(const WTimerTraceRec_& r)                                 // a tick's record: no formatting, no I/O
+         {
+#if WTIMER_TRACE
+           if (_trace && _log_ticks.load(std::memory_order_relaxed))   _trace->push(r) ;
+#endif
+         }
+    void trace_consumer() ;                                              // ... its thread: to _trace_sink or, Log_to()
+    void log_trace(const WTimerTraceRec_& r) const& ;
+    WTimerHandle_ register_event(cWTimerEventsDB_::Node_handle&& nh,     // relink an extracted one: the same handle
+                                 bool fl_cons, uint64_t skip = 0) ;
 
   public:
                                   // constructors & destructor
     explicit cWTimer_(uint32_t capacity, uint32_t period,                // {# slots, period in millis}
-                      int   delay_correction = 0,                        // compensate for wait_for() delay
-                      size_t deb_capacity = 0,                           // capacity of debug collection
-                      std::string&& id = {}) ;
+                      int   delay_correction = 0,                        // obsolete: ignored, nothing to compensate
+                      bool debug = false,                                // debug collection: histograms, see cWTimerDebug_
+                      std::string&& id = {},
+                      uint32_t levels = 0,                               // hierarchical: # of upper levels, 0 - flat
+                      WTickSource_ source = WTickSource_::CONDVAR) ;     // ticking: what the Timer sleeps on
+    template <typename Int, typename = std::enable_if_t<std::is_integral_v<Int> && !std::is_same_v<Int, bool>>>
+    cWTimer_(uint32_t, uint32_t, int, Int,                               // 'debug' was 'size_t deb_capacity': an integer
+             std::string&& = {}, uint32_t = 0,                           // ... there is an old call site - refused
+             WTickSource_ = WTickSource_::CONDVAR) = delete ;
+    explicit cWTimer_(uint32_t capacity, std::chrono::microseconds period, // ... high resolution: HYBRID, mostly
+                      bool debug = false, std::string&& id = {}, uint32_t levels = 0,
+                      WTickSource_ source = WTickSource_::HYBRID) ;
     ~cWTimer_() ;
 
                                   // operations
     bool start() ;                                                       // commence Scheduling; @return: if successful
     void stop() ;                                                        // send a signal to stop
 
+    bool reserve(size_t events) ;                                        // preallocate nodes for 'events' in total
+    void log_ticks(bool on) { _log_ticks.store(on) ; }                   // a trace record per tick: on by default
+    bool set_trace(size_t capacity, bool overwrite = true,               // before start(): the ring, full: the oldest
+                   std::function<void(const WTimerTraceRec_&)> sink = {}) ; // ... overwritten or, the newest dropped
+
+    bool set_tickless(bool on) ;                                         // before start(): no idle wake-ups
+    bool set_virtual(bool on) ;                                          // ... virtual clock: no thread, see advance()
+    bool set_overrun(WTOverrun_ policy,                                  // ... when a tick misses its deadline
+                     uint32_t budget = 0) ;                              // ... SPREAD: call-backs per tick at most
+    uint64_t advance(uint64_t ticks) ;                                   // ... run 'ticks' now: @return # fired
+    bool set_affinity(int cpu) ;                                         // before start(): pin the Timer's thread; -1: not
+    bool set_spin(std::chrono::nanoseconds window) ;                     // ... HYBRID: spin for the last 'window' of a tick
+    bool set_dispatch(uint32_t workers,                                  // before start(): workers for non-inlay
+                      size_t capacity = 4096,                            // ... queued call-backs at most
+                      WTBackpressure_ policy = WTBackpressure_::RUN_INLINE) ;
+    bool set_pool(std::shared_ptr<WTimerPool_t> pool) ;                  // ... or, a pool shared with other Timers
+
     /*bool register_event(AppCB_ cb *??? Copiable/Movable *,             // C-style
                         void* args, size_t args_size * C-style * ,
                         uint32_t period  * in Timer ticks * ,
                         bool is_recurrent * if periodic or one-time *
                        ) ; // register cWTimerEvent_(ie place it in cWTimerEventsDB_, @return - is success
     **/
-    bool register_event(const cWTimerEvent_& ev, bool fl_cons = false) ; // schedule 'ev', @return - if successful
-    bool register_event(cWTimerEvent_&& ev, bool fl_cons = false) ;      // ...
+    WTimerHandle_ register_event(cWTimerEvent_&& ev, bool fl_cons = false) ;      // schedule 'ev', @return - its handle; thread-safe
+                                                                         // ... none: recurrent, dispatched & move-only -
+                                                                         // ... a copy per firing, see cWTimerEvent_
+    template <typename Range>                                            // of cWTimerEvent_: moved from
+    std::vector<WTimerHandle_> register_events(Range&& evs) ;            // ... all at once: a handle per event; none:
+                                                                         // ... out of memory, nothing registered
+
+    bool cancel(const WTimerHandle_& h)                                  // O(1), thread-safe: @return if it was pending
+         { return _events.cancel(h, this->on_timer_thread()) ; }
+    bool reschedule(const WTimerHandle_& h, uint32_t ticks)              // ... to fire 'ticks' after the current tick
+         { bool owner = this->on_timer_thread(), res = _events.reschedule(h, ticks, owner) ;
+           if (res && !owner && _tickless)   this->wake_up() ;
+           return res ; }
 
                                   // descriptive
     operator bool() const& { return _isOK ; }
+    cWTimerDebug_& debug() & { return _deb_coll ; }                      // its histograms: snapshot() or take(), any thread
+    WTimerStats_ stats() const& ;                                        // any thread: lock-free, consistent
+    uint64_t now() const& { return _events.now() ; }                     // the current absolute tick: Timer's thread
+    uint64_t missed() const& { return _missed_now ; }                    // ... a call-back's firings coalesced into this one
+    WTickSource_ tick_source() const& { return _source_kind ; }
+    std::vector<uint32_t> population() const& ;                          // # per slot (all levels): relaxed reads
 
                                   // external
     friend std::ostream& operator<< (std::ostream& os, const cWTimer_& wt) ;
@@ -200,21 +677,76 @@ class cWTimer_ { // not a template as to have the possibility of changing charac
   private:
                                   // properties:
     const uint32_t    _capacity{0} ;                                     // =:: # of slots
-    uint32_t    _period{0} ;                                             // period(of a tick) in milli-seconds
-    int         _delay_corr{0} ;                                         // correct delay of wait_for() in micros: initial
+    std::chrono::microseconds   _period{0} ;                              // period(of a tick): millis or, micros
     std::string _id{} ;                                                  // Id
 
     std::thread          _th{} ;                                         // thread performing
     std::promise<void>   _sstop{} ;                                      // signal STOP to _timer_function()
+    std::atomic<std::thread::id>   _tid{} ;                              // set by _timer_function()
 
                                   // dynamic attributes
-    Rotation_t   _tick ;                                                 // # of the current slot
-    Tick_t       _rotation ;                                             // ...  rotation
-
-    cWTimerEventsDB_   _events{} ;                                       // all Scheduled events
-
-    bool            _isOK{false} ;
-    cWTimerDebug_   _deb_coll{} ;                                        // collect debug information
+    Tick_t       _tick ;                                                 // # of the current slot
+    Rotation_t   _rotation ;                                             // ...  rotation
+
+    cWTimerEventsDB_   _events ;                                         // all Scheduled events
+
+    std::shared_ptr<WTimerPool_t>   _pool{} ;                            // executes the dispatched call-backs: by start()
+    std::vector<AppCallable_>       _batch{} ;                           // ... of the current tick
+    uint32_t                        _pool_workers{0} ;                   // 0: hardware concurrency - 1
+    size_t                          _pool_capacity{4096} ;
+    WTBackpressure_                 _pool_policy{WTBackpressure_::RUN_INLINE} ;
+
+    int                       _cpu{-1} ;                                 // the Timer's thread: pinned to, if >= 0
+    const WTickSource_        _source_kind{WTickSource_::CONDVAR} ;
+    std::unique_ptr<cWTickSource_>   _source{} ;                         // by start(): ticking only
+    int64_t                   _start_ns{0} ;                             // ... its time-base: CLOCK_MONOTONIC
+    std::chrono::nanoseconds  _spin{std::chrono::microseconds{100}} ;   // ... HYBRID: the OS' wake-up latency, or so
+    bool                      _tickless{false} ;                         // sleep to the next non-empty slot
+    bool                      _virtual{false} ;                          // ticks run by advance(): call-backs in place
+    WTOverrun_                _overrun{WTOverrun_::CATCH_UP} ;
+    uint32_t                  _budget{0} ;                               // SPREAD: call-backs per tick, 0 - any
+    uint64_t                  _missed_now{0} ;                           // see missed()
+    std::vector<cWTimerEventsDB_::Node_handle>   _deferred{} ;           // SPREAD: over the budget, to the next tick
+    std::atomic<bool>         _idle{false} ;                             // ... sleeping: to be woken up by producers
+    bool                      _woken{false} ;                            // ... under _wake_m
+    std::mutex                _wake_m{} ;
+    std::condition_variable   _wake_cv{} ;
+
+    bool                _isOK{false} ;
+    std::atomic<bool>   _log_ticks{true} ;                               // see log_ticks()
+#if WTIMER_TRACE
+    std::unique_ptr<cWTimerTraceRing_<WTimerTraceRec_>>   _trace{} ;    // by start(): if on or, a sink is set
+    std::function<void(const WTimerTraceRec_&)>          _trace_sink{} ;
+    size_t                                               _trace_capacity{1024} ;
+    bool                                                 _trace_overwrite{true} ;
+    std::thread                                          _trace_th{} ;  // the consumer
+    std::atomic<bool>                                    _trace_stop{false} ;
+#endif
+    cWTimerDebug_       _deb_coll{} ;                                    // collect debug information
+    int64_t             _due_ns{0} ;                                     // ... the current tick's deadline
+    WTimerStats_        _tally{} ;                                       // Timer's thread: counted as it goes
+    Published_          _stats{} ;                                       // ... as of the last tick: see stats()
 }; // class cWTimer_
 
+template <typename Range>
+std::vector<WTimerHandle_>
+cWTimer_::register_events(Range&& evs)                                   // the Timer sees none or, all of them
+{
+   std::vector<WTimerHandle_>   hs ;
+   if (!this->on_timer_thread()) {                                       // a single push: drained in the same tick
+      _events.post_events(std::begin(evs), std::end(evs),               // the refused: as by register_event()
+                          [this](const cWTimerEvent_& ev) { return this->dispatchable(ev) ; }, hs) ;
+      if (_tickless)   this->wake_up() ;
+      return hs ;
+   }
+
+   _events.add_events(std::begin(evs), std::end(evs),
+                      [this](const cWTimerEvent_& ev) -> std::optional<cWTimerEventsDB_::Key> {
+                         auto  res = this->calc_request(ev) ;
+                         if (!res)   return std::nullopt ;
+                         return _events.make_key(res->first, res->second) ;
+                      }, hs) ;
+   return hs ;
+}
+
 #endif // WHEEL_TIMER_HPP
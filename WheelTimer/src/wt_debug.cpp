@@ -4,35 +4,31 @@
 #include "wheel_timer.hpp"
 
 
-cWTimerDebug_::cWTimerDebug_(size_t cap, uint32_t ticks) : _coll{}, _tir{ticks}
+static std::ostream&
+in_micros(std::ostream& os, const WTimerHistogramSnapshot_& s)          // recorded in nanos
 {
-   try {
-      _coll.reserve(cap) ;
-   } catch (...) { _coll = {} ; }
+   return os << s._count << " > avg " << s.mean() / 1000.0 << " p50 " << s.percentile(50) / 1000.0
+             << " p99 " << s.percentile(99) / 1000.0 << " p99.9 " << s.percentile(99.9) / 1000.0
+             << " max " << s._max / 1000.0 << " micros" ;
 }
 
                                   // external
 std::ostream& operator<< (std::ostream& os, const cWTimerDebug_& wtd)
 {
-   size_t                     count_jits = wtd._coll.size() ;
-   cWTimerDebug_::Jitter_type max_jit = 0 ;
-   cWTimerDebug_::Jitter_type avg_jit = 0 ;
-
    os << "> DEBUG > " ;
-   if (count_jits > 0) {
-      int   max_jit = 0 ;
-      os << count_jits << " jitters ( _/! = deadline met/MISSED )\n:: " ;
-      uint32_t count = 0 ; uint32_t first_missed = count_jits ;              // cosmetics
-      for (const auto [jit, missed_period]: wtd._coll) {
-         os << jit << (missed_period ? (first_missed = count, '!') : '_') ;
-         avg_jit += jit ;
-         if (jit > max_jit)   max_jit = jit ;
-         if (++count == wtd._tir) { count = 0 ; os << "\n:: " ; }            // cosmetics
-      }
-      os << "\n> avg jitter " << (avg_jit / count_jits) << " max_jitter " << max_jit ;
-      if (first_missed < count_jits)   os << " > first MISSED " << first_missed << '\n' ;
-      else                             os << " > all deadlines met\n" ;
-   } else os << "no informations collected" ;
+   if (!wtd.on())   return os << "no informations collected" ;
+
+   auto   jit = wtd._jitter.snapshot() ;
+   if (jit._count == 0)   return os << "no ticks yet" ;
+   in_micros(os << "ticks: ", jit) << '\n' ;
+   in_micros(os << ":: work-loads: ", wtd._work_load.snapshot()) << '\n' ;
+   in_micros(os << ":: call-backs' lateness: ", wtd._lateness.snapshot()) << '\n' ;
+   auto   spin = wtd._spin.snapshot() ;
+   if (spin._count > 0)   in_micros(os << ":: spun (hybrid): ", spin) << '\n' ;
+
+   auto   missed = wtd._missed.load(std::memory_order_relaxed) ;
+   if (missed > 0)   os << "> deadlines MISSED: " << missed << '\n' ;
+   else              os << "> all deadlines met\n" ;
 
    return os ;
 }
@@ -5,10 +5,11 @@
 
                                   // cWTimerEvent_:: constructors, ...
 cWTimerEvent_::cWTimerEvent_(uint32_t period_in_ticks, bool isR,
-                             const AppCB_& func, bool isInlay)
+                             AppCallable_&& func, bool isInlay, uint32_t slack_in_ticks)
              : _wt_ticks{period_in_ticks}, _is_recurrent{isR}
-             , _cb{func}
+             , _cb{std::move(func)}
              , _inlay{isInlay}                                  // call _cb immediately or dispatch it
+             , _slack{slack_in_ticks}
 {
 
 }
@@ -17,7 +18,9 @@ cWTimerEvent_::cWTimerEvent_(uint32_t period_in_ticks, bool isR,
 std::ostream& operator<< (std::ostream& os, const cWTimerEvent_& wt)
 {
    os << "ev{period:" << wt._wt_ticks << "t, recurrent:"
-      << std::boolalpha << wt._is_recurrent << "}" ;
+      << std::boolalpha << wt._is_recurrent ;
+   if (wt._slack)   os << ", slack:" << wt._slack << "t" ;
+   os << "}" ;
    return os ;
 }
 
@@ -3,41 +3,542 @@
 
 #include "wheel_timer.hpp"
 
+#include <algorithm>
+
                                   // cWTimerEventsDB_:: constructors, ...
+cWTimerEventsDB_::cWTimerEventsDB_(uint32_t slots, uint32_t levels)
+                : _capacity{slots}, _levels{levels}, _now{0}
+                , _slots(slots + (size_t)levels * LEVEL_SLOTS)
+                , _occupancy((_slots.size() + 63) / 64)
+                , _chunks{std::make_unique<std::atomic<Node_*>[]>(MAX_CHUNKS)}
+                , _sth{}
+{
+   assert(slots != 0 && levels <= MAX_LEVELS) ;
+
+   _qstub = this->alloc_node() ;                                         // the queue of posted is never empty
+   _qhead.store(_qstub, std::memory_order_relaxed), _qtail = _qstub ;
+
+   _gran[0] = 1 ;
+   for (uint32_t k = 1 ; k <= _levels ; ++k) {                           // level k slot: _capacity * 64^(k-1) ticks
+      _gran[k] = k == 1 ? _capacity : _gran[k - 1] * LEVEL_SLOTS ;
+   }
+}
+
+cWTimerEventsDB_::~cWTimerEventsDB_()
+{
+   if (_sth.joinable()) _sth.join() ;
+
+   auto count = std::min(_nchunks.load(), MAX_CHUNKS) ;                  // events still in, go with their chunks
+   for (uint32_t c = 0 ; c < count ; ++c)   delete[] _chunks[c].load() ;
+}
 
                                   // cWTimerEventsDB_:: operations
+WTimerHandle_
+cWTimerEventsDB_::add_event(Key&& k, Value&& v)                          // k: contructed with make_key(),
+{
+   try {
+      auto ix = this->alloc_node() ;
+      auto& n = this->node(ix) ;
+      try { n._ev.emplace(std::move(v)) ; } catch (...) { this->free_node(ix) ; throw ; }
+      n._when = this->when_of(k), this->link(ix) ;
+                                                                         // Log_to(0, ": just added &&: ", k.first, k.second) ;
+      return this->handle_of(ix) ;
+   } catch (...) { return WTimerHandle_{} ; }                            // Strong Exception Safety guarantee
+}
+
+WTimerHandle_
+cWTimerEventsDB_::add_event(const Key& k, Node_handle&& nh)              // nh: from extract() or, take_posted()
+{
+   assert(nh._db == this) ;
+   auto ix = nh._ix ;
+   nh._db = nullptr ;                                                    // the node: not to be released
+
+   this->node(ix)._when = this->when_of(k), this->link(ix) ;
+   return this->handle_of(ix) ;                                          // the same as when registered
+}
+
 bool
-cWTimerEventsDB_::add_event(const Key& k, const Value& v)                // k: contructed with make_key(),
+cWTimerEventsDB_::settled(Node_handle& nh)                               // after its call-back: @return if taken care of
+{
+   assert(nh._db == this) ;
+   auto  ix = nh._ix ;
+   auto& n = this->node(ix) ;
+   auto  c = n._ctl.load(std::memory_order_acquire) ;
+
+   if (c & (F_QUEUED | F_CANCEL)) { nh = Node_handle{} ; return true ; } // the pool or, take_posted() decides
+   if (!(c & F_RESCHED))   return false ;                                // as per its period
+
+   while (!n._ctl.compare_exchange_weak(c, c & ~(F_RESCHED | TICKS_MASK),
+                                        std::memory_order_acq_rel, std::memory_order_acquire)) ;
+   nh._db = nullptr ;
+   n._when = _now + (c & TICKS_MASK), this->link(ix) ;                   // rescheduled by its own call-back
+   return true ;
+}
+
+void
+cWTimerEventsDB_::defer(std::vector<Node_handle>& nhs, uint64_t when)   // ahead of the ones due at 'when' already
+{
+   for (auto i = nhs.size() ; i-- > 0 ; ) {                              // at the head: the last one first
+      assert(nhs[i]._db == this) ;
+      auto ix = nhs[i]._ix ;
+      nhs[i]._db = nullptr ;
+      this->node(ix)._when = when, this->link(ix, true) ;
+   }
+   nhs.clear() ;
+}
+
+                                  // cWTimerEventsDB_:: operations: thread-safe
+WTimerHandle_
+cWTimerEventsDB_::post_event(Value&& v)                                  // a node & a few atomics: no locks
 {
    try {
-      const auto& it = this->_events.emplace(k, v) ;
-                                                                         // Log_to(0, ": just added const&: ", it) ;
-   } catch (...) { return false ; }                                      // Strong Exception Safety guarantee
+      auto ix = this->alloc_node() ;
+      auto& n = this->node(ix) ;
+      try { n._ev.emplace(std::move(v)) ; } catch (...) { this->free_node(ix) ; throw ; }
+      n._where = Where_::NEW, n._ctl.fetch_or(F_QUEUED, std::memory_order_relaxed) ;
+      auto h = this->handle_of(ix) ;
+      _posted.fetch_add(1, std::memory_order_relaxed) ;
+      this->push_posted(ix) ;
+      return h ;
+   } catch (...) { return WTimerHandle_{} ; }
+}
+
+cWTimerEventsDB_::Node_handle
+cWTimerEventsDB_::take_posted()                                          // applies the requests; @return the ones
+{                                                                        // to be scheduled as per their period
+   for (auto ix = this->pop_posted() ; ix != NIL ; ix = this->pop_posted()) {
+      auto& n = this->node(ix) ;
+      auto  c = n._ctl.load(std::memory_order_acquire) ;
+      if (n._where == Where_::NEW)   _posted.fetch_sub(1, std::memory_order_relaxed) ;   // a registration: cancelled or, not
+      while (!n._ctl.compare_exchange_weak(c, c & ~(F_QUEUED | F_RESCHED | TICKS_MASK),
+                                           std::memory_order_acq_rel, std::memory_order_acquire)) ;
+
+      if (c & F_CANCEL) {
+         if (n._where == Where_::LINKED)   this->unlink(ix) ;
+         this->release_node(ix) ;
+      } else if (c & F_RESCHED) {
+         if (n._where == Where_::LINKED)   this->unlink(ix) ;
+         n._when = _now + (c & TICKS_MASK), this->link(ix) ;
+      } else if (n._where != Where_::LINKED) {
+         return Node_handle{this, ix} ;                                  // NEW or, fired while queued
+      }
+   }
+   return Node_handle{} ;
+}
+
+bool
+cWTimerEventsDB_::cancel(const WTimerHandle_& h, bool owner)             // others: flagged & queued, to be freed
+{                                                                        // at the start of the next tick
+   auto* n = this->node_of(h) ;
+   if (!n)   return false ;
+
+   auto  c = n->_ctl.load(std::memory_order_acquire) ;
+   do {
+      if ((uint32_t)(c >> GEN_SHIFT) != h._gen || (c & F_CANCEL))   return false ;
+   } while (!n->_ctl.compare_exchange_weak(c, c | F_CANCEL | (owner ? 0 : F_QUEUED),
+                                           std::memory_order_acq_rel, std::memory_order_acquire)) ;
+
+   if (!owner)   { if (!(c & F_QUEUED))   this->push_posted(h._ix) ; }
+   else if (!(c & F_QUEUED) && n->_where == Where_::LINKED) {            // else: take_posted() or, settled()
+      this->unlink(h._ix), this->release_node(h._ix) ;
+   }
    return true ;
 }
 
 bool
-cWTimerEventsDB_::add_event(Key&& k, Value&& v)                          // k: contructed with make_key(),
+cWTimerEventsDB_::reschedule(const WTimerHandle_& h, uint32_t ticks, bool owner)
+{
+   auto* n = this->node_of(h) ;
+   if (!n)   return false ;
+
+   auto  c = n->_ctl.load(std::memory_order_acquire) ;
+   for ( ; ; ) {
+      if ((uint32_t)(c >> GEN_SHIFT) != h._gen || (c & F_CANCEL))   return false ;
+      if (owner && !(c & F_QUEUED) && n->_where == Where_::LINKED)   break ;  // right away
+
+      auto r = (c & ~TICKS_MASK) | F_RESCHED | ticks | (owner ? 0 : F_QUEUED) ;
+      if (n->_ctl.compare_exchange_weak(c, r, std::memory_order_acq_rel, std::memory_order_acquire)) {
+         if (!owner && !(c & F_QUEUED))   this->push_posted(h._ix) ;
+         return true ;
+      }
+   }
+
+   this->unlink(h._ix) ;
+   n->_when = _now + ticks, this->link(h._ix) ;
+   return true ;
+}
+
+cWTimerEventsDB_::Index_t
+cWTimerEventsDB_::pop_posted()                                           // MPSC (D. Vyukov's): the consumer side
+{
+   auto tail = _qtail ;
+   auto next = this->node(tail)._qnext.load(std::memory_order_acquire) ;
+
+   if (tail == _qstub) {                                                 // skip the stub
+      if (next == NIL)   return NIL ;
+      _qtail = tail = next ;
+      next = this->node(tail)._qnext.load(std::memory_order_acquire) ;
+   }
+   if (next == NIL) {                                                    // the last one: or, a producer in the middle
+      if (tail != _qhead.load(std::memory_order_acquire))   return NIL ; // ... get it at the next call
+      this->push_posted(_qstub) ;
+      next = this->node(tail)._qnext.load(std::memory_order_acquire) ;
+      if (next == NIL)   return NIL ;
+   }
+
+   _qtail = next ;
+   _queued.fetch_sub(1, std::memory_order_relaxed) ;
+   return tail ;
+}
+
+                                  // cWTimerEventsDB_:: operations: Timer's thread
+void
+cWTimerEventsDB_::advance()                                              // the wheel moves to _now + 1
+{
+   ++_now ;
+   if (_levels == 0 || _now % _gran[1] != 0)   return ;                  // not a new rotation: nothing to cascade
+
+   uint32_t   top = 1 ;                                                  // the highest level, whose slot has passed
+   while (top < _levels && _now % _gran[top + 1] == 0)   ++top ;
+   for (uint32_t k = top ; k > 0 ; --k)   this->cascade(k) ;             // higher first: they may land in lower ones
+}
+
+void
+cWTimerEventsDB_::advance_to(uint64_t when)                              // tickless: the slots in between are empty
+{
+   assert(when > _now && when <= this->next_due()) ;
+   _now = when - 1 ;                                                     // no cascade due before 'when'
+   this->advance() ;
+}
+
+uint64_t
+cWTimerEventsDB_::next_due() const&                                      // bitmap scans: level 0 & a word per upper level
+{
+   auto   due = UINT64_MAX ;
+   auto   from = (uint32_t)(_now % _capacity) ;
+
+   if (auto s = this->occupied(from, _capacity) ; s != _capacity)   due = _now + (s - from) ;
+   else if (_levels == 0) {                                              // flat: or, the next rotation (maybe early)
+      if (auto s = this->occupied(0, from) ; s != from)   due = _now + (_capacity - from) + s ;
+   }
+
+   for (uint32_t lv = 1 ; lv <= _levels ; ++lv) {                        // the next non-empty slot: its cascade
+      auto   base = _capacity + (lv - 1) * LEVEL_SLOTS ;
+      auto   cur = (uint32_t)((_now / _gran[lv]) % LEVEL_SLOTS) ;
+      auto   s = this->occupied(base + cur + 1, base + LEVEL_SLOTS) ;    // the current one: cascaded already
+      auto   d = s != base + LEVEL_SLOTS ? s - base - cur
+                                         : this->occupied(base, base + cur) - base + LEVEL_SLOTS - cur ;
+      if (d < LEVEL_SLOTS)   due = std::min(due, (_now / _gran[lv] + d) * _gran[lv]) ;
+   }
+   return due ;
+}
+
+bool
+cWTimerEventsDB_::reserve(size_t n)                                      // makes whole chunks: the fresh ones
 {
    try {
-      const auto& it = this->_events.emplace(std::move(k), std::move(v)) ;
-                                                                         // Log_to(0, ": just added &&: ", it) ;
-   } catch (...) { return false ; }                                      // Strong Exception Safety guarantee
+      if (n + 1 > ((size_t)MAX_CHUNKS << CHUNK_SHIFT))   return false ;  // + 1: the stub of the queue
+      for (uint32_t c = 0 ; c <= (n >> CHUNK_SHIFT) ; ++c)   this->make_chunk(c) ;
+   } catch (...) { return false ; }
    return true ;
 }
+
+size_t
+cWTimerEventsDB_::countof(const Key& k) const&                           // walks the slots 'k' might be in only
+{
+   auto     when = this->when_of(k) ;
+   size_t   count = this->count_in(k.second % _capacity, when) ;
+
+   for (uint32_t lv = 1 ; lv <= _levels ; ++lv) {
+      bool   beyond = lv == _levels && when / _gran[lv] - _now / _gran[lv] >= LEVEL_SLOTS ;
+      auto   base = _capacity + (lv - 1) * LEVEL_SLOTS ;
+      if (beyond)   for (uint32_t s = 0 ; s < LEVEL_SLOTS ; ++s)   count += this->count_in(base + s, when) ;
+      else          count += this->count_in(base + (when / _gran[lv]) % LEVEL_SLOTS, when) ;
+   }
+   return count ;
+}
+
+                                  // cWTimerEventsDB_:: private: the pool
+cWTimerEventsDB_::Index_t
+cWTimerEventsDB_::alloc_node()                                           // O(1), but for making a chunk
+{
+   auto head = _free.load(std::memory_order_acquire) ;
+   for ( ; ; ) {
+      auto ix = (Index_t)head ;
+      if (ix == NIL)   return this->alloc_fresh(1) ;
+
+      auto next = this->node(ix)._qnext.load(std::memory_order_relaxed) ;
+      if (_free.compare_exchange_weak(head, (((head >> 32) + 1) << 32) | next,
+                                      std::memory_order_acquire, std::memory_order_acquire))   return ix ;
+   }
+}
+
+void
+cWTimerEventsDB_::alloc_nodes(size_t n, std::vector<Index_t>& ixs)       // appended to ixs; may throw
+{
+   constexpr size_t   AT_ONCE = 256 ;                                    // the walk before a CAS: bounded
+   while (ixs.size() < n) {
+      auto  head = _free.load(std::memory_order_acquire) ;
+      auto  got = ixs.size() ;
+      auto  ix = (Index_t)head ;
+      if (ix == NIL) {                                                   // the rest: in a single step
+         auto f = this->alloc_fresh(n - got) ;
+         for (auto i = got ; i < n ; ++i)   ixs.push_back(f++) ;
+         break ;
+      }
+
+      for (size_t k = 0 ; ix != NIL && k < AT_ONCE && ixs.size() < n ; ++k) {   // stale, if the CAS fails
+         ixs.push_back(ix), ix = this->node(ix)._qnext.load(std::memory_order_relaxed) ;
+      }
+      if (!_free.compare_exchange_strong(head, (((head >> 32) + 1) << 32) | ix,
+                                         std::memory_order_acquire, std::memory_order_relaxed))   ixs.resize(got) ;
+   }
+}
+
+cWTimerEventsDB_::Index_t
+cWTimerEventsDB_::alloc_fresh(size_t n)                                  // a CAS for any n: no walking of a list
+{
+   auto  f = _fresh.load(std::memory_order_relaxed) ;
+   do {
+      if (f + n > ((uint64_t)MAX_CHUNKS << CHUNK_SHIFT))   throw std::bad_alloc{} ;
+   } while (!_fresh.compare_exchange_weak(f, f + n, std::memory_order_relaxed)) ;
+
+   for (auto c = f >> CHUNK_SHIFT ; c <= (f + n - 1) >> CHUNK_SHIFT ; ++c)   this->make_chunk((uint32_t)c) ;
+   return (Index_t)f ;                                                   // lost, if a chunk could not be made
+}
+
+cWTimerEventsDB_::Node_*
+cWTimerEventsDB_::make_chunk(uint32_t c)
+{
+   auto* chunk = _chunks[c].load(std::memory_order_acquire) ;
+   if (chunk)   return chunk ;
+
+   auto* made = new Node_[CHUNK_MASK + 1] ;                              // might throw: its entry stays empty
+   if (!_chunks[c].compare_exchange_strong(chunk, made, std::memory_order_acq_rel, std::memory_order_acquire)) {
+      delete[] made ;                                                    // made by another one meanwhile
+      return chunk ;
+   }
+   for (auto k = _nchunks.load(std::memory_order_relaxed) ;
+        k <= c && !_nchunks.compare_exchange_weak(k, c + 1, std::memory_order_release, std::memory_order_relaxed) ; ) ;
+   return made ;
+}
+
+void
+cWTimerEventsDB_::free_node(Index_t ix)                                  // the node: already unlinked
+{
+   auto& n = this->node(ix) ;
+   n._ev.reset(), n._prev = n._next = NIL ;
+   this->push_free(ix, ix) ;
+}
+
+void
+cWTimerEventsDB_::release_node(Index_t ix)                               // the node: not linked
+{
+   auto& n = this->node(ix) ;
+   auto  c = n._ctl.load(std::memory_order_acquire) ;
+
+   n._where = Where_::DETACHED ;
+   do {
+      if (c & F_QUEUED)   return ;                                       // take_posted() will see to it
+   } while (!n._ctl.compare_exchange_weak(c, ((c >> GEN_SHIFT) + 1) << GEN_SHIFT, // stale handles: all of them
+                                          std::memory_order_acq_rel, std::memory_order_acquire)) ;
+   this->free_node(ix) ;
+}
+
+cWTimerEventsDB_::Node_*
+cWTimerEventsDB_::node_of(const WTimerHandle_& h)                        // any thread: no trust in 'h'
+{
+   if (!h || h._ix == _qstub)   return nullptr ;
+
+   auto c = h._ix >> CHUNK_SHIFT ;
+   if (c >= std::min(_nchunks.load(std::memory_order_acquire), MAX_CHUNKS))   return nullptr ;
+   auto* chunk = _chunks[c].load(std::memory_order_acquire) ;
+   return chunk ? &chunk[h._ix & CHUNK_MASK] : nullptr ;
+}
+
+void
+cWTimerEventsDB_::push_free(Index_t first, Index_t last)
+{
+   auto& l = this->node(last) ;
+   auto  head = _free.load(std::memory_order_relaxed) ;
+   do {
+      l._qnext.store((Index_t)head, std::memory_order_relaxed) ;
+   } while (!_free.compare_exchange_weak(head, (((head >> 32) + 1) << 32) | first,
+                                         std::memory_order_release, std::memory_order_relaxed)) ;
+}
+
+void
+cWTimerEventsDB_::push_posted(Index_t first, Index_t last, size_t n)     // MPSC: the producers' side
+{
+   if (n > 0)   _queued.fetch_add(n, std::memory_order_relaxed) ;
+   this->node(last)._qnext.store(NIL, std::memory_order_relaxed) ;
+   auto prev = _qhead.exchange(last, std::memory_order_acq_rel) ;
+   this->node(prev)._qnext.store(first, std::memory_order_release) ;    // the consumer might wait for this one
+}
+
+                                  // cWTimerEventsDB_:: private: slots
+uint32_t
+cWTimerEventsDB_::slot_of(uint64_t when) const&                          // the lowest level that can tell 'when' from _now
+{
+   if (_levels == 0 || when < _now || when / _capacity == _now / _capacity) {
+      return (uint32_t)(when % _capacity) ;                              // level 0
+   }
+
+   for (uint32_t lv = 1 ; lv <= _levels ; ++lv) {
+      if (when / _gran[lv] - _now / _gran[lv] < LEVEL_SLOTS) {
+         return _capacity + (lv - 1) * LEVEL_SLOTS + (uint32_t)((when / _gran[lv]) % LEVEL_SLOTS) ;
+      }
+   }                                                                     // beyond the top level: park it in its last slot
+   return _capacity + (_levels - 1) * LEVEL_SLOTS + (uint32_t)((_now / _gran[_levels] + LEVEL_SLOTS - 1) % LEVEL_SLOTS) ;
+}
+
+void
+cWTimerEventsDB_::link(Index_t ix, bool front)
+{
+   auto& n = this->node(ix) ;
+   n._slot = this->slot_of(n._when) ;
+   auto& s = _slots[n._slot] ;
+
+   if (n._when == _gathered && n._slot < _capacity)   front = true ;    // due in the tick being extracted: still in it
+   n._where = Where_::LINKED ;
+   if (s._head == NIL)   _occupancy[n._slot / 64] |= 1ull << (n._slot % 64) ;
+   if (front) {
+      n._prev = NIL, n._next = s._head ;
+      if (s._head != NIL)   this->node(s._head)._prev = ix ;
+      else                  s._tail = ix ;
+      s._head = ix ;
+   } else {
+      n._prev = s._tail, n._next = NIL ;
+      if (s._tail != NIL)   this->node(s._tail)._next = ix ;
+      else                  s._head = ix ;
+      s._tail = ix ;
+   }
+   _max_depth = std::max(_max_depth, s.add(1)) ;
+   ++_size ;
+}
+
+void
+cWTimerEventsDB_::unlink(Index_t ix)
+{
+   auto& n = this->node(ix) ;
+   auto& s = _slots[n._slot] ;
+
+   if (n._prev != NIL)   this->node(n._prev)._next = n._next ;
+   else                  s._head = n._next ;
+   if (n._next != NIL)   this->node(n._next)._prev = n._prev ;
+   else                  s._tail = n._prev ;
+   if (s._head == NIL)   _occupancy[n._slot / 64] &= ~(1ull << (n._slot % 64)) ;
+   n._prev = n._next = NIL, n._where = Where_::DETACHED ;
+   s.add(-1) ;
+   --_size ;
+}
+
+void
+cWTimerEventsDB_::splice(uint32_t slot, const Slot_& chain)              // O(1): the chain's nodes know their slot
+{
+   auto& s = _slots[slot] ;
+   if (s._tail != NIL)   this->node(s._tail)._next = chain._head, this->node(chain._head)._prev = s._tail ;
+   else                  s._head = chain._head, _occupancy[slot / 64] |= 1ull << (slot % 64) ;
+   s._tail = chain._tail ;
+   _max_depth = std::max(_max_depth, s.add(chain._count.load(std::memory_order_relaxed))) ;
+}
+
+void
+cWTimerEventsDB_::cascade(uint32_t level)                                // called as the slot of 'level' becomes current
+{
+   auto   slot = _capacity + (level - 1) * LEVEL_SLOTS + (uint32_t)((_now / _gran[level]) % LEVEL_SLOTS) ;
+   auto&  s = _slots[slot] ;
+   auto   ix = s._head ;
+
+   s._head = s._tail = NIL, s._count.store(0, std::memory_order_relaxed), _occupancy[slot / 64] &= ~(1ull << (slot % 64)) ;
+   while (ix != NIL) {                                                   // each one goes lower or, stays if beyond
+      auto next = this->node(ix)._next ;
+      --_size, this->link(ix) ;
+      ix = next ;
+   }
+}
+
+size_t
+cWTimerEventsDB_::count_in(uint32_t slot, uint64_t when) const&
+{
+   size_t   count = 0 ;
+   for (auto ix = _slots[slot]._head ; ix != NIL ; ix = this->node(ix)._next) {
+      if (this->node(ix)._when == when)   ++count ;
+   }
+   return count ;
+}
+
+uint32_t
+cWTimerEventsDB_::occupied(uint32_t from, uint32_t to) const&            // a word at a time
+{
+   for (auto s = from ; s < to ; ) {
+      auto   bits = _occupancy[s / 64] >> (s % 64) ;
+      if (bits)   return std::min(to, s + (uint32_t)__builtin_ctzll(bits)) ;
+      s += 64 - s % 64 ;
+   }
+   return to ;
+}
+
+cWTimerEventsDB_::Node_handle
+cWTimerEventsDB_::extract_key(const Key& k)                              // the 1st in the slot with Key{r, t}: O(1)
+{                                                                        // ... but for the 1st call of a tick
+   auto   when = this->when_of(k) ;
+   auto   slot = k.second % _capacity ;
+   if (_gathered != when)   this->gather(slot, when), _gathered = when ;
+
+   for (auto ix = _slots[slot]._head ; ix != NIL && this->node(ix)._when == when ; ix = _slots[slot]._head) {
+      auto& n = this->node(ix) ;
+      this->unlink(ix) ;
+      if (!(n._ctl.load(std::memory_order_acquire) & F_ALL))   return Node_handle{this, ix} ;
+      this->release_node(ix) ;                                           // cancelled/rescheduled: not to fire
+   }
+   return Node_handle{} ;
+}
+
+void
+cWTimerEventsDB_::gather(uint32_t slot, uint64_t when)                   // in order: the others stay as they were
+{
+   auto&    s = _slots[slot] ;
+   Index_t  last = NIL ;                                                 // the due ones so far: the last of them
+   for (auto ix = s._head ; ix != NIL ; ) {
+      auto& n = this->node(ix) ;
+      auto  next = n._next ;
+      if (n._when == when) {
+         if (n._prev != last) {                                          // out of place: after 'last' (or, the head)
+            this->node(n._prev)._next = n._next ;
+            if (n._next != NIL)   this->node(n._next)._prev = n._prev ;
+            else                  s._tail = n._prev ;
+            n._prev = last, n._next = last != NIL ? this->node(last)._next : s._head ;
+            this->node(n._next)._prev = ix ;                             // there is one: 'ix' was behind it
+            if (last != NIL)   this->node(last)._next = ix ;
+            else               s._head = ix ;
+         }
+         last = ix ;
+      }
+      ix = next ;
+   }
+}
+
                                   // cWTimerEventsDB_:: helpers
 std::ostream& operator<< (std::ostream& os, const cWTimerEventsDB_& wt)
 {
    // os << "> events DB holds " << wt._events.size() << " events:" ;
-   for (const auto& [k, ev] : wt._events) os << "\n: [" << k.first << ", " << k.second << "]: " << ev ;
+   for (const auto& s : wt._slots) {
+      for (auto ix = s._head ; ix != cWTimerEventsDB_::NIL ; ix = wt.node(ix)._next) {
+         const auto& n = wt.node(ix) ;
+         auto [r, t] = wt.key_of(n._when) ;
+         os << "\n: [" << r << ", " << t << "]: " << *(n._ev) ;
+      }
+   }
 
    return os ;
 }
 
-std::ostream& operator<< (std::ostream& os, const cWTimerEventsDB_::Iterator& it)
-{                                                                        // an element of events DB
-   auto [r, t] = it->first ;
-   os << "[" << r << ", " << t << "]: " << it->second ;
+std::ostream& operator<< (std::ostream& os, const cWTimerEventsDB_::Node_handle& nh)
+{                                                                        // an extracted element of events DB
+   if (!nh)   return os << "[]" ;
+   auto [r, t] = nh.key() ;
+   os << "[" << r << ", " << t << "]: " << nh.mapped() ;
    return os ;
 }
 
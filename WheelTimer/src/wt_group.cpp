@@ -0,0 +1,179 @@
+// wt_group.cpp: as defined in wt_group.hpp: construction, routing, ...
+//
+
+#include "wt_group.hpp"
+
+#include <algorithm>
+#include <thread>
+
+#include <sched.h>
+
+                                  // cWTimerGroup_:: constructors, ...
+cWTimerGroup_::cWTimerGroup_(const std::vector<int>& cpus, uint32_t capacity, uint32_t period,
+                             uint32_t levels, std::string&& id, bool debug)
+             : _cpus{cpus}
+             , _counters{std::make_unique<Counters_[]>(std::max<size_t>(cpus.size(), 1))}
+{
+   if (_cpus.empty())   _cpus.push_back(-1) ;                            // a shard at least
+
+   _pool = std::make_shared<WTimerPool_t>(std::max(2u, std::thread::hardware_concurrency()) - 1) ;
+   _shards.reserve(_cpus.size()) ;
+   for (size_t s = 0 ; s < _cpus.size() ; ++s) {
+      _shards.emplace_back(std::make_unique<cWTimer_>(capacity, period, 0, debug, id + "#" + std::to_string(s), levels)) ;
+      _shards.back()->set_pool(_pool) ;                                  // not a pool per shard: hw - 1 workers in all
+      if (_cpus[s] >= 0)   _shards.back()->set_affinity(_cpus[s]) ;
+   }
+
+   size_t   ncpus = std::max<size_t>(std::thread::hardware_concurrency(), 1) ;
+   for (auto c : _cpus)   ncpus = std::max<size_t>(ncpus, (size_t)c + 1) ;
+   _cpu_shard.resize(ncpus) ;
+   for (size_t c = 0 ; c < ncpus ; ++c)   _cpu_shard[c] = (uint32_t)(c % _shards.size()) ;
+   for (size_t s = 0 ; s < _cpus.size() ; ++s)   if (_cpus[s] >= 0)   _cpu_shard[_cpus[s]] = (uint32_t)s ;
+}
+
+                                  // cWTimerGroup_:: operations
+bool
+cWTimerGroup_::start()
+{
+   for (size_t s = 0 ; s < _shards.size() ; ++s) {
+      if (!_shards[s]->start()) {                                        // the started ones: stopped
+         for (size_t r = 0 ; r < s ; ++r)   _shards[r]->stop() ;
+         return false ;
+      }
+   }
+   return true ;
+}
+
+void
+cWTimerGroup_::stop()
+{
+   for (auto& s : _shards)   if (*s)   s->stop() ;
+}
+
+bool
+cWTimerGroup_::reserve(size_t events)
+{
+   bool   res = true ;
+   for (auto& s : _shards)   res = s->reserve(events) && res ;
+   return res ;
+}
+
+void
+cWTimerGroup_::log_ticks(bool on)
+{
+   for (auto& s : _shards)   s->log_ticks(on) ;
+}
+
+bool
+cWTimerGroup_::set_tickless(bool on)
+{
+   bool   res = true ;
+   for (auto& s : _shards)   res = s->set_tickless(on) && res ;
+   return res ;
+}
+
+bool
+cWTimerGroup_::set_dispatch(uint32_t workers, size_t capacity, WTBackpressure_ policy)
+{
+   for (auto& s : _shards)   if (*s)   return false ;                    // already started
+   try {
+      _pool = std::make_shared<WTimerPool_t>(workers, capacity, policy) ;
+   } catch (...) { return false ; }
+   bool   res = true ;
+   for (auto& s : _shards)   res = s->set_pool(_pool) && res ;
+   return res ;
+}
+
+                                  // cWTimerGroup_:: operations:: events
+WTimerGroupHandle_
+cWTimerGroup_::register_event(cWTimerEvent_&& ev)
+{
+   return this->add(this->shard_of_cpu(), std::move(ev)) ;
+}
+
+WTimerGroupHandle_
+cWTimerGroup_::register_event(uint64_t key, cWTimerEvent_&& ev)
+{
+   return this->add(this->shard_of(key), std::move(ev)) ;
+}
+
+bool
+cWTimerGroup_::cancel(const WTimerGroupHandle_& h)
+{
+   if (h._shard >= _shards.size() || !_shards[h._shard]->cancel(h._h))   return false ;
+   _counters[h._shard]._cancelled.fetch_add(1, std::memory_order_relaxed) ;
+   return true ;
+}
+
+bool
+cWTimerGroup_::reschedule(const WTimerGroupHandle_& h, uint32_t ticks)
+{
+   if (h._shard >= _shards.size() || !_shards[h._shard]->reschedule(h._h, ticks))   return false ;
+   _counters[h._shard]._rescheduled.fetch_add(1, std::memory_order_relaxed) ;
+   return true ;
+}
+
+                                  // cWTimerGroup_:: descriptive
+uint32_t
+cWTimerGroup_::shard_of(uint64_t key) const&                             // splitmix64's finalizer: keys in sequence spread
+{
+   key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ull ;
+   key = (key ^ (key >> 27)) * 0x94d049bb133111ebull ;
+   key ^= key >> 31 ;
+   return (uint32_t)(((key >> 32) * _shards.size()) >> 32) ;             // [0, # shards): no division
+}
+
+uint32_t
+cWTimerGroup_::shard_of_cpu() const&
+{
+   int   cpu = sched_getcpu() ;
+   if (cpu < 0)   return 0 ;
+   return (size_t)cpu < _cpu_shard.size() ? _cpu_shard[cpu] : (uint32_t)(cpu % _shards.size()) ;
+}
+
+WTimerGroupStats_
+cWTimerGroup_::stats() const&                                            // a sum of relaxed reads: not a snapshot
+{                                                                        // ... each shard's stats(): consistent
+   WTimerGroupStats_   st{} ;
+   auto&               t = st._timers ;
+   for (size_t s = 0 ; s < _shards.size() ; ++s) {
+      const auto&  c = _counters[s] ;
+      st._registered  += c._registered.load(std::memory_order_relaxed) ;
+      st._rejected    += c._rejected.load(std::memory_order_relaxed) ;
+      st._cancelled   += c._cancelled.load(std::memory_order_relaxed) ;
+      st._rescheduled += c._rescheduled.load(std::memory_order_relaxed) ;
+
+      auto   sh = _shards[s]->stats() ;
+      t._ticks += sh._ticks, t._fired += sh._fired, t._rescheduled += sh._rescheduled, t._dropped += sh._dropped ;
+      t._missed += sh._missed, t._scheduled += sh._scheduled, t._posted += sh._posted ;
+      t._max_depth = std::max(t._max_depth, sh._max_depth) ;
+      t._caught_up += sh._caught_up, t._skips += sh._skips, t._coalesced += sh._coalesced ;
+      t._over_budget += sh._over_budget, t._deferred += sh._deferred ;
+      if (_shards[s]->debug().on())   st._lateness += _shards[s]->debug()._lateness.snapshot() ;
+   }
+   return st ;
+}
+
+                                  // cWTimerGroup_:: private
+WTimerGroupHandle_
+cWTimerGroup_::add(uint32_t s, cWTimerEvent_&& ev)
+{
+   auto   h = _shards[s]->register_event(std::move(ev)) ;
+   if (!h)   return _counters[s]._rejected.fetch_add(1, std::memory_order_relaxed), WTimerGroupHandle_{} ;
+   _counters[s]._registered.fetch_add(1, std::memory_order_relaxed) ;
+   return WTimerGroupHandle_{s, h} ;
+}
+
+                                  // cWTimerGroup_:: external functions
+std::ostream& operator<< (std::ostream& os, const cWTimerGroup_& g)
+{
+   auto   st = g.stats() ;
+   os << "group{shards:" << g._shards.size() << ", registered:" << st._registered << ", rejected:" << st._rejected
+      << ", cancelled:" << st._cancelled << ", rescheduled:" << st._rescheduled << ", CPUs:" ;
+   for (auto c : g._cpus)   os << " " << c ;
+   os << ", " << st._timers ;
+   if (st._lateness._count)   os << ", lateness(nanos):" << st._lateness ;
+   return os << "}" ;
+}
+
+// eof wt_group.cpp
@@ -0,0 +1,87 @@
+// wt_group.hpp: a group of Wheel Timers (shards), each one pinned to a CPU
+//    - one cWTimer_ per shard: its own thread & events DB; the workers - one pool shared by all the shards
+//    - registering: routed by a key's hash or, by the caller's CPU (the shard pinned to it, if any)
+//    - a handle knows its shard: cancel() & reschedule() go to the owner
+//    - stats: per shard counters (cache-line padded) & the shards' own stats(), aggregated on request
+//
+
+#ifndef WT_GROUP_HPP
+#define WT_GROUP_HPP
+
+#include "wheel_timer.hpp"
+
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <string>
+
+
+struct WTimerGroupHandle_ {       // {shard, its handle}
+  uint32_t        _shard{UINT32_MAX} ;
+  WTimerHandle_   _h{} ;
+
+  explicit operator bool() const& { return _shard != UINT32_MAX && _h ; }
+  bool operator== (const WTimerGroupHandle_& h) const& { return _shard == h._shard && _h == h._h ; }
+}; // struct WTimerGroupHandle_
+
+struct WTimerGroupStats_ {        // as aggregated over the shards
+  uint64_t   _registered{0} ;                                            // registering: counted by the group
+  uint64_t   _rejected{0} ;                                              // no room: no handle returned
+  uint64_t   _cancelled{0} ;
+  uint64_t   _rescheduled{0} ;
+  WTimerStats_               _timers{} ;                                 // the shards' stats(), summed: the deepest slot
+  WTimerHistogramSnapshot_   _lateness{} ;                               // ... call-backs' lateness, merged: debug only
+}; // struct WTimerGroupStats_
+
+class cWTimerGroup_ {
+
+  struct alignas(64) Counters_ {  // a shard's: written by the registering threads
+    std::atomic<uint64_t>   _registered{0}, _rejected{0}, _cancelled{0}, _rescheduled{0} ;
+  }; // struct Counters_
+
+  public:
+                                  // constructors & destructor
+    cWTimerGroup_(const std::vector<int>& cpus,                          // a shard per entry, pinned to; -1: not pinned
+                  uint32_t capacity, uint32_t period,                    // as per cWTimer_: # slots, period in millis
+                  uint32_t levels = 0, std::string&& id = {},
+                  bool debug = false) ;                                  // the shards' histograms: see cWTimerDebug_
+    cWTimerGroup_(const cWTimerGroup_&) = delete ;
+    cWTimerGroup_& operator= (const cWTimerGroup_&) = delete ;
+    ~cWTimerGroup_() = default ;                                         // the shards stop & join as cWTimer_
+
+                                  // operations
+    bool start() ;                                                       // all the shards or, none
+    void stop() ;
+
+    bool reserve(size_t events) ;                                        // per shard
+    void log_ticks(bool on) ;
+    bool set_tickless(bool on) ;
+    bool set_dispatch(uint32_t workers, size_t capacity = 4096,          // the shared pool: instead of the default one
+                      WTBackpressure_ policy = WTBackpressure_::RUN_INLINE) ;
+
+    WTimerGroupHandle_ register_event(cWTimerEvent_&& ev) ;              // to the shard of the caller's CPU
+    WTimerGroupHandle_ register_event(uint64_t key, cWTimerEvent_&& ev) ; // ... of the key's hash
+    bool cancel(const WTimerGroupHandle_& h) ;                           // by the owner shard
+    bool reschedule(const WTimerGroupHandle_& h, uint32_t ticks) ;
+
+                                  // descriptive
+    uint32_t shards() const& { return (uint32_t)_shards.size() ; }
+    uint32_t shard_of(uint64_t key) const& ;                             // routing: by hash
+    uint32_t shard_of_cpu() const& ;                                     // ... by the caller's CPU
+    cWTimer_& shard(uint32_t s) & { return *_shards[s] ; }
+    WTimerGroupStats_ stats() const& ;
+
+                                  // external
+    friend std::ostream& operator<< (std::ostream& os, const cWTimerGroup_& g) ;
+
+  private:
+    WTimerGroupHandle_ add(uint32_t s, cWTimerEvent_&& ev) ;
+
+    std::vector<std::unique_ptr<cWTimer_>>   _shards{} ;
+    std::vector<int>                         _cpus{} ;                   // of the shards
+    std::vector<uint32_t>                    _cpu_shard{} ;              // CPU -> shard: pinned to or, round robin
+    std::unique_ptr<Counters_[]>             _counters{} ;
+    std::shared_ptr<WTimerPool_t>            _pool{} ;                   // the shards' workers: by the 1st dispatch
+}; // class cWTimerGroup_
+
+#endif // WT_GROUP_HPP
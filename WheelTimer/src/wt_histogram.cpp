@@ -0,0 +1,67 @@
+// wt_histogram.cpp: as defined in wt_histogram.hpp: snapshots, percentiles, ...
+//
+
+#include "wt_histogram.hpp"
+
+#include <algorithm>
+
+                                  // WTimerHistogramSnapshot_::
+uint64_t
+WTimerHistogramSnapshot_::highest_of(uint32_t b)
+{
+   if (b < SUB)   return b ;
+   uint32_t  e = (b - SUB) / (SUB / 2) + 1 ;
+   uint64_t  m = (b - SUB) % (SUB / 2) + SUB / 2 ;
+   return ((m + 1) << e) - 1 ;                                           // the last bucket's: wraps to 2^64 - 1
+}
+
+uint64_t
+WTimerHistogramSnapshot_::percentile(double p) const&
+{
+   if (_count == 0)   return 0 ;
+   uint64_t  rank = (uint64_t)(p / 100.0 * _count + 0.5) ;               // the rank-th value, 1 at least
+   if (rank == 0)   rank = 1 ;
+   uint64_t  seen = 0 ;
+   for (uint32_t b = 0 ; b < BUCKETS ; ++b)
+      if ((seen += _counts[b]) >= rank)   return std::min(highest_of(b), _max) ;
+   return _max ;
+}
+
+WTimerHistogramSnapshot_&
+WTimerHistogramSnapshot_::operator+= (const WTimerHistogramSnapshot_& s) &   // the same buckets: no precision lost
+{
+   for (uint32_t b = 0 ; b < BUCKETS ; ++b)   _counts[b] += s._counts[b] ;
+   _count += s._count, _sum += s._sum, _max = std::max(_max, s._max) ;
+   return *this ;
+}
+
+std::ostream& operator<< (std::ostream& os, const WTimerHistogramSnapshot_& s)
+{
+   return os << "{n:" << s._count << ", mean:" << s.mean() << ", p50:" << s.percentile(50) << ", p99:" << s.percentile(99)
+             << ", p99.9:" << s.percentile(99.9) << ", max:" << s._max << "}" ;
+}
+
+                                  // cWTimerHistogram_::
+WTimerHistogramSnapshot_
+cWTimerHistogram_::take() &                                              // a concurrent record(): in this one or, the next
+{
+   Snapshot_   s ;
+   for (uint32_t b = 0 ; b < Snapshot_::BUCKETS ; ++b)
+      s._count += (s._counts[b] = _counts[b].exchange(0, std::memory_order_relaxed)) ;
+   s._sum = _sum.exchange(0, std::memory_order_relaxed) ;
+   s._max = _max.exchange(0, std::memory_order_relaxed) ;
+   return s ;
+}
+
+WTimerHistogramSnapshot_
+cWTimerHistogram_::snapshot() const&
+{
+   Snapshot_   s ;
+   for (uint32_t b = 0 ; b < Snapshot_::BUCKETS ; ++b)
+      s._count += (s._counts[b] = _counts[b].load(std::memory_order_relaxed)) ;
+   s._sum = _sum.load(std::memory_order_relaxed) ;
+   s._max = _max.load(std::memory_order_relaxed) ;
+   return s ;
+}
+
+// eof wt_histogram.cpp
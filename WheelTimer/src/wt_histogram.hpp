@@ -0,0 +1,64 @@
+// wt_histogram.hpp: a fixed memory, log-linear (HDR like) histogram of latencies
+//    - exact below 64, then 32 sub-buckets per power of 2: 1/32 relative error at most, over [0, 2^64)
+//    - record(): O(1), no allocation, lock-free - a relaxed increment (& a CAS, when the max is exceeded)
+//    - snapshot(): copied from any thread; take(): ... & reset, by exchanges - no record lost in between
+//
+
+#ifndef WT_HISTOGRAM_HPP
+#define WT_HISTOGRAM_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+
+
+class cWTimerHistogram_ ;
+
+struct WTimerHistogramSnapshot_ { // a plain copy: percentiles, etc
+  static constexpr uint32_t   SUB_BITS = 6 ;
+  static constexpr uint32_t   SUB = 1u << SUB_BITS ;                     // exact values below
+  static constexpr uint32_t   BUCKETS = SUB + (64 - SUB_BITS) * (SUB / 2) ;
+
+  std::array<uint64_t, BUCKETS>   _counts{} ;
+  uint64_t                        _count{0} ;
+  uint64_t                        _sum{0} ;
+  uint64_t                        _max{0} ;
+
+  uint64_t percentile(double p) const& ;                                 // p in [0, 100]: the bucket's highest, _max at most
+  uint64_t mean() const& { return _count ? _sum / _count : 0 ; }
+  WTimerHistogramSnapshot_& operator+= (const WTimerHistogramSnapshot_& s) & ;   // merged: another histogram's
+
+  static uint32_t bucket_of(uint64_t v)
+                  { if (v < SUB)   return (uint32_t)v ;
+                    uint32_t  e = 64 - SUB_BITS - __builtin_clzll(v) ;   // >= 1: the bits dropped
+                    return SUB + (e - 1) * (SUB / 2) + (uint32_t)(v >> e) - SUB / 2 ; }
+  static uint64_t highest_of(uint32_t b) ;                               // the highest value of bucket b
+
+  friend std::ostream& operator<< (std::ostream& os, const WTimerHistogramSnapshot_& s) ;
+}; // struct WTimerHistogramSnapshot_
+
+class cWTimerHistogram_ {
+  using Snapshot_ = WTimerHistogramSnapshot_ ;
+
+  public:
+                                  // operations
+    void record(int64_t v)                                               // negatives: as 0
+         { uint64_t  u = v < 0 ? 0 : (uint64_t)v ;
+           _counts[Snapshot_::bucket_of(u)].fetch_add(1, std::memory_order_relaxed) ;
+           _sum.fetch_add(u, std::memory_order_relaxed) ;
+           for (auto m = _max.load(std::memory_order_relaxed) ; u > m && !_max.compare_exchange_weak(m, u, std::memory_order_relaxed) ; ) ; }
+
+    Snapshot_ take() & ;                                                 // snapshot & reset
+    void reset() & { (void)this->take() ; }
+
+                                  // descriptive
+    Snapshot_ snapshot() const& ;                                        // relaxed reads: not atomic as a whole
+
+  private:
+    std::array<std::atomic<uint64_t>, Snapshot_::BUCKETS>   _counts{} ;
+    std::atomic<uint64_t>                                   _sum{0} ;
+    std::atomic<uint64_t>                                   _max{0} ;
+}; // class cWTimerHistogram_
+
+#endif // WT_HISTOGRAM_HPP
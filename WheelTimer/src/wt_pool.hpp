@@ -0,0 +1,213 @@
+// wt_pool.hpp: work-stealing pool of worker threads: executes the call-backs dispatched by cWTimer_
+//    - a bounded ring (deque) per worker: the owner takes from the front, the idle ones steal from the back
+//    - submit(): a batch at a time (a tick's due call-backs), spread over the workers - from any thread
+//    - the workers: started by the 1st submit() - a pool never submitted to costs no threads
+//    - back-pressure when all rings are full: run on the submitter's thread, drop or wait for room
+//
+
+#ifndef WT_POOL_HPP
+#define WT_POOL_HPP
+
+#include <stdint.h>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <ostream>
+#include <utility>
+#include <iterator>
+
+#include <assert.h>
+
+
+enum class WTBackpressure_ { RUN_INLINE,                                 // the submitter runs the excess itself
+                             DROP,                                       // ... drops it (counted)
+                             BLOCK                                       // ... waits for room
+                           } ;
+
+template <typename Task>                                                 // Task: callable, default constructible
+class cWTimerPool_ {
+
+  struct Deque_ {                 // bounded ring of a worker
+    std::mutex          _m{} ;
+    std::vector<Task>   _ring{} ;
+    size_t              _head{0} ;                                       // the oldest
+    size_t              _count{0} ;
+
+    bool push(Task&& t)  { if (_count == _ring.size()) return false ;
+                           _ring[(_head + _count++) % _ring.size()] = std::move(t) ; return true ; }
+    bool pop_front(Task& t) { if (_count == 0) return false ;
+                              t = std::move(_ring[_head]), _head = (_head + 1) % _ring.size(), --_count ; return true ; }
+    bool pop_back(Task& t)  { if (_count == 0) return false ;
+                              t = std::move(_ring[(_head + --_count) % _ring.size()]) ; return true ; }
+  }; // struct Deque_
+
+  public:
+                                  // constructors & destructor
+    explicit cWTimerPool_(uint32_t workers, size_t capacity = 4096,     // {# workers, # queued tasks at most}
+                          WTBackpressure_ policy = WTBackpressure_::RUN_INLINE)
+            : _deques(workers ? workers : 1), _policy{policy}
+    {
+       auto per_worker = (capacity + _deques.size() - 1) / _deques.size() ;
+       for (auto& d : _deques)   d._ring.resize(per_worker ? per_worker : 1) ;
+    }
+    cWTimerPool_(const cWTimerPool_&) = delete ;
+    cWTimerPool_& operator= (const cWTimerPool_&) = delete ;
+    ~cWTimerPool_() { this->stop() ; }
+
+                                  // operations
+    template <typename Coll>
+    size_t submit(Coll& batch) ;                                         // moves from batch; @return # queued
+    void   stop() ;                                                      // the queued are executed first
+
+                                  // descriptive
+    uint32_t workers() const& { return (uint32_t)_deques.size() ; }
+    WTBackpressure_ policy() const& { return _policy ; }
+    size_t   pending() const& { return _pending.load(std::memory_order_relaxed) ; }
+    uint64_t dropped() const& { return _dropped.load(std::memory_order_relaxed) ; }
+
+    friend std::ostream& operator<< (std::ostream& os, const cWTimerPool_& p)
+    {
+       os << "pool{workers:" << p._deques.size() << ", executed:" << p._executed.load()
+          << ", stolen:" << p._stolen.load() << ", inlined:" << p._inlined.load()
+          << ", dropped:" << p._dropped.load() << "}" ;
+       return os ;
+    }
+
+  private:
+    void start_workers() ;                                               // by the 1st submit()
+    void work(uint32_t w) ;                                              // a worker's loop
+    bool take(uint32_t w, Task& t) ;                                     // own front or, steal
+    void wake(size_t n) ;
+
+    std::vector<Deque_>        _deques ;
+    std::vector<std::thread>   _workers{} ;
+    WTBackpressure_            _policy ;
+    std::once_flag             _started{} ;
+    std::atomic<uint32_t>      _next{0} ;                                // round robin start: the submitters
+
+    std::atomic<size_t>        _pending{0} ;                             // queued, not taken yet
+    std::atomic<uint32_t>      _sleepers{0} ;
+    std::atomic<bool>          _stop{false} ;
+    std::mutex                 _idle_m{} ;
+    std::condition_variable    _idle_cv{} ;
+
+    std::atomic<uint64_t>      _executed{0}, _stolen{0}, _inlined{0}, _dropped{0} ;
+}; // class cWTimerPool_
+
+
+                                  // cWTimerPool_:: operations
+template <typename Task> template <typename Coll>
+size_t
+cWTimerPool_<Task>::submit(Coll& batch)                                  // a lock per worker's ring, a wake-up at most
+{
+   std::call_once(_started, &cWTimerPool_::start_workers, this) ;
+
+   size_t   queued = 0 ;
+   auto     it = std::begin(batch), end = std::end(batch) ;
+   size_t   left = (size_t)std::distance(it, end) ;
+   uint32_t rings = _workers.empty() ? 0 : (uint32_t)_deques.size() ;    // no threads: as if all full
+   uint32_t first = _next.fetch_add(1, std::memory_order_relaxed) ;
+
+   _pending.fetch_add(left) ;                                            // before any of them can be taken
+
+   for (uint32_t tried = 0 ; left > 0 && tried < rings ; ++tried) {
+      auto&  d = _deques[(first + tried) % rings] ;
+      size_t share = (left + rings - tried - 1) / (rings - tried) ;
+
+      std::lock_guard<std::mutex>   lk{d._m} ;
+      for ( ; share > 0 && d.push(std::move(*it)) ; --share, --left, ++it)   ++queued ;
+   }
+   if (left > 0)     _pending.fetch_sub(left) ;
+   if (queued > 0)   this->wake(queued) ;
+
+   for ( ; it != end ; ++it) {                                           // all the rings are full
+      switch (rings ? _policy : WTBackpressure_::RUN_INLINE) {           // no threads: no waiting for them
+         case WTBackpressure_::RUN_INLINE: (*it)(), _inlined.fetch_add(1, std::memory_order_relaxed) ; break ;
+         case WTBackpressure_::DROP:       _dropped.fetch_add(1, std::memory_order_relaxed) ; break ;
+         case WTBackpressure_::BLOCK:
+            _pending.fetch_add(1) ;
+            for (bool done = false ; !done ; ) {
+               for (auto& d : _deques) {
+                  std::lock_guard<std::mutex>   lk{d._m} ;
+                  if ((done = d.push(std::move(*it))))   break ;
+               }
+               if (!done)   std::this_thread::yield() ;
+            }
+            ++queued, this->wake(1) ;
+            break ;
+      }
+   }
+   return queued ;
+}
+
+template <typename Task>
+void
+cWTimerPool_<Task>::stop()
+{
+   if (_stop.exchange(true))   return ;
+   { std::lock_guard<std::mutex> lk{_idle_m} ; }
+   _idle_cv.notify_all() ;
+   for (auto& th : _workers)   if (th.joinable())   th.join() ;
+}
+
+                                  // cWTimerPool_:: private
+template <typename Task>
+void
+cWTimerPool_<Task>::start_workers()                                      // once: by a submitter
+{
+   try {
+      _workers.reserve(_deques.size()) ;
+      for (uint32_t w = 0 ; w < _deques.size() ; ++w)   _workers.emplace_back(&cWTimerPool_::work, this, w) ;
+   } catch (...) {}                                                      // fewer: theirs stolen by the others
+}
+
+template <typename Task>
+void
+cWTimerPool_<Task>::wake(size_t n)                                       // the lock: only if someone sleeps
+{
+   if (_sleepers.load() == 0)   return ;
+   { std::lock_guard<std::mutex> lk{_idle_m} ; }
+   if (n == 1)   _idle_cv.notify_one() ;
+   else          _idle_cv.notify_all() ;
+}
+
+template <typename Task>
+bool
+cWTimerPool_<Task>::take(uint32_t w, Task& t)
+{
+   {  std::lock_guard<std::mutex>   lk{_deques[w]._m} ;
+      if (_deques[w].pop_front(t))   return true ;
+   }
+   for (uint32_t i = 1 ; i < _deques.size() ; ++i) {                     // steal: the newest of another one
+      auto&  d = _deques[(w + i) % _deques.size()] ;
+      std::unique_lock<std::mutex>   lk{d._m, std::try_to_lock} ;
+      if (lk && d.pop_back(t))   return _stolen.fetch_add(1, std::memory_order_relaxed), true ;
+   }
+   return false ;
+}
+
+template <typename Task>
+void
+cWTimerPool_<Task>::work(uint32_t w)
+{
+   Task   t{} ;
+   for ( ; ; ) {
+      if (this->take(w, t)) {
+         _pending.fetch_sub(1) ;
+         t(), _executed.fetch_add(1, std::memory_order_relaxed) ;
+         continue ;
+      }
+      if (_pending.load() > 0)   { std::this_thread::yield() ; continue ; } // a busy ring: try again
+
+      std::unique_lock<std::mutex>   lk{_idle_m} ;
+      _sleepers.fetch_add(1) ;
+      _idle_cv.wait(lk, [this] { return _pending.load() > 0 || _stop.load() ; }) ;
+      _sleepers.fetch_sub(1) ;
+      if (_pending.load() == 0 && _stop.load())   return ;
+   }
+}
+
+#endif // WT_POOL_HPP
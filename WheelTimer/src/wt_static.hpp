@@ -0,0 +1,271 @@
+// wt_static.hpp: a Wheel Timer of a fixed geometry: Slots (a power of 2) x PeriodUs, known at compile time
+//    - slot math: shifts & masks, the slots: a std::array - nothing decided in run-time
+//    - the same events, call-backs & handles as cWTimer_: cWTimerEvent_, AppCallable_, WTimerHandle_
+//    - a flat wheel: a slot holds the events of all rotations for its tick
+//    - one owner thread: the one calling tick(), advance() or run() - call-backs included; no posting, no locks
+//
+
+#ifndef WT_STATIC_HPP
+#define WT_STATIC_HPP
+
+#include "wheel_timer.hpp"
+
+#include <array>
+#include <deque>
+#include <chrono>
+
+#include <time.h>
+#include <errno.h>
+
+
+template <uint32_t Slots, uint32_t PeriodUs>
+class cWTimerStatic_ {
+  static_assert(Slots >= 2 && (Slots & (Slots - 1)) == 0, "cWTimerStatic_: Slots is to be a power of 2") ;
+  static_assert(PeriodUs > 0, "cWTimerStatic_: a tick of 1 micro at least") ;
+
+  using Index_t = uint32_t ;
+
+  static constexpr Index_t    NIL = UINT32_MAX ;
+  static constexpr uint32_t   SHIFT = __builtin_ctz(Slots) ;
+  static constexpr uint64_t   MASK = Slots - 1 ;
+
+  enum class State_ : uint8_t { FREE, LINKED, DUE, FIRING, CANCELLED } ;   // DUE: out of its slot, to fire
+
+  struct Node_ {                  // the links: what a slot's walk touches, compact - the events apart
+    uint64_t   _when{0} ;                                                // absolute tick
+    Index_t    _prev{NIL} ;
+    Index_t    _next{NIL} ;                                              // ... or, the free list
+    uint32_t   _gen{0} ;
+    State_     _state{State_::FREE} ;
+  }; // struct Node_
+
+  struct Slot_ {
+    Index_t   _head{NIL} ;
+    Index_t   _tail{NIL} ;
+  }; // struct Slot_
+
+  public:
+                                  // constructors & destructor
+    cWTimerStatic_() = default ;
+    cWTimerStatic_(const cWTimerStatic_&) = delete ;
+    cWTimerStatic_& operator= (const cWTimerStatic_&) = delete ;
+
+                                  // operations: the owner's
+    bool reserve(size_t events) ;                                        // nodes: not to grow while ticking
+
+    WTimerHandle_ register_event(cWTimerEvent_&& ev) ;                   // due in its period from the current tick
+    bool cancel(const WTimerHandle_& h) ;                                // O(1): @return if it was pending
+    bool reschedule(const WTimerHandle_& h, uint32_t ticks) ;            // ... to fire 'ticks' (>= 1) after the current tick
+
+    size_t tick() ;                                                      // the current one: @return # fired
+    size_t advance(uint64_t ticks) ;                                     // ... 'ticks' in a row: a virtual clock
+    void   run(const std::atomic<bool>& stop) ;                          // a tick per PeriodUs: absolute deadlines
+
+                                  // descriptive
+    static constexpr uint32_t slots() { return Slots ; }
+    static constexpr std::chrono::microseconds period() { return std::chrono::microseconds{PeriodUs} ; }
+    uint64_t now() const& { return _now ; }                              // absolute tick
+    uint64_t rotation() const& { return _now >> SHIFT ; }
+    uint32_t slot() const& { return (uint32_t)(_now & MASK) ; }
+    size_t   size() const& { return _size ; }
+
+  private:
+    Node_*  node_of(const WTimerHandle_& h)
+            { if (h._ix >= _nodes.size())   return nullptr ;
+              auto& n = _nodes[h._ix] ;
+              return n._gen == h._gen && n._state != State_::FREE ? &n : nullptr ; }
+    Index_t new_node() { _nodes.emplace_back(), _events.resize(_nodes.size()) ; return (Index_t)_nodes.size() - 1 ; }
+    Index_t alloc_node() ;
+    void    free_node(Index_t ix) ;
+    void    link(Index_t ix, uint64_t when) ;                            // at the tail of its slot
+    void    unlink(Index_t ix) ;
+    uint64_t next_busy(uint64_t end) const& ;                            // the 1st tick in [_now, end) to look at
+
+    std::array<Slot_, Slots>   _slots{} ;
+    std::array<uint64_t, (Slots + 63) / 64>   _busy{} ;                  // a bit per non-empty slot
+    std::vector<Node_>         _nodes{} ;
+    std::deque<std::optional<cWTimerEvent_>>   _events{} ;               // never move: a call-back may register
+    Index_t                    _free{NIL} ;
+    Index_t                    _firing{NIL} ;                            // tick(): the one whose call-back runs
+    std::vector<Index_t>       _due{} ;                                  // tick(): out of the slot, to fire
+    uint64_t                   _now{0} ;
+    size_t                     _size{0} ;                                // # linked
+}; // class cWTimerStatic_
+
+                                  // cWTimerStatic_:: operations
+template <uint32_t Slots, uint32_t PeriodUs>
+bool
+cWTimerStatic_<Slots, PeriodUs>::reserve(size_t events)
+{
+   try {
+      _due.reserve(events) ;
+      _nodes.reserve(events) ;
+      while (_nodes.size() < events)   this->free_node(this->new_node()) ;
+   } catch (...) { return false ; }
+   return true ;
+}
+
+template <uint32_t Slots, uint32_t PeriodUs>
+WTimerHandle_
+cWTimerStatic_<Slots, PeriodUs>::register_event(cWTimerEvent_&& ev)
+{
+   try {
+      auto  ix = this->alloc_node() ;
+      auto  when = ev.aligned(_now + ev.in_ticks().first) ;              // within its slack, if any
+      try { _events[ix].emplace(std::move(ev)) ; } catch (...) { this->free_node(ix) ; throw ; }
+      this->link(ix, when) ;
+      return WTimerHandle_{ix, _nodes[ix]._gen} ;
+   } catch (...) { return WTimerHandle_{} ; }
+}
+
+template <uint32_t Slots, uint32_t PeriodUs>
+bool
+cWTimerStatic_<Slots, PeriodUs>::cancel(const WTimerHandle_& h)
+{
+   auto* n = this->node_of(h) ;
+   if (!n || n->_state == State_::CANCELLED)   return false ;
+   switch (n->_state) {
+      case State_::LINKED: this->unlink(h._ix) ;                        // rescheduled by its call-back: tick() frees it
+                           if (h._ix == _firing)   n->_state = State_::CANCELLED ;
+                           else                    this->free_node(h._ix) ;
+                           break ;
+      default:             n->_state = State_::CANCELLED ; break ;      // tick() frees it: in its hands
+   }
+   return true ;
+}
+
+template <uint32_t Slots, uint32_t PeriodUs>
+bool
+cWTimerStatic_<Slots, PeriodUs>::reschedule(const WTimerHandle_& h, uint32_t ticks)
+{
+   auto* n = this->node_of(h) ;
+   if (!n || n->_state == State_::CANCELLED)   return false ;
+   if (n->_state == State_::LINKED)   this->unlink(h._ix) ;
+   this->link(h._ix, _now + std::max(ticks, 1u)) ;                       // DUE/FIRING: tick() leaves it be; 1 at least,
+                                                                         // ... as calc_request(): the current slot, walked
+   return true ;
+}
+
+template <uint32_t Slots, uint32_t PeriodUs>
+size_t
+cWTimerStatic_<Slots, PeriodUs>::tick()
+{
+   auto&  s = _slots[_now & MASK] ;
+   for (auto ix = s._head ; ix != NIL ; ) {                              // the due ones: out, in order
+      auto  next = _nodes[ix]._next ;
+      if (_nodes[ix]._when == _now)   this->unlink(ix), _nodes[ix]._state = State_::DUE, _due.push_back(ix) ;
+      ix = next ;
+   }
+
+   size_t   fired = 0 ;
+   for (size_t i = 0 ; i < _due.size() ; ++i) {                          // call-backs may cancel/reschedule any
+      auto  ix = _due[i] ;
+      if (_nodes[ix]._state == State_::CANCELLED) { this->free_node(ix) ; continue ; }
+      if (_nodes[ix]._state != State_::DUE)   continue ;                 // rescheduled meanwhile
+
+      _nodes[ix]._state = State_::FIRING, _firing = ix ;
+      auto&  ev = *_events[ix] ;
+      if (auto& cb = ev.call_back())   cb(), ++fired ;
+      _firing = NIL ;
+
+      auto   state = _nodes[ix]._state ;                                 // _nodes: may have grown meanwhile
+      if (state == State_::FIRING && ev.is_recurrent())   this->link(ix, ev.aligned(_now + ev.in_ticks().first)) ;
+      else if (state != State_::LINKED)   this->free_node(ix) ;         // one-time or, cancelled by its call-back
+   }
+   _due.clear() ;
+   ++_now ;
+   return fired ;
+}
+
+template <uint32_t Slots, uint32_t PeriodUs>
+size_t
+cWTimerStatic_<Slots, PeriodUs>::advance(uint64_t ticks)
+{
+   size_t   fired = 0 ;
+   for (auto end = _now + ticks ; (_now = this->next_busy(end)) < end ; )   // the empty ones: skipped
+      fired += this->tick() ;
+   return fired ;
+}
+
+template <uint32_t Slots, uint32_t PeriodUs>
+void
+cWTimerStatic_<Slots, PeriodUs>::run(const std::atomic<bool>& stop)      // as cWTimer_'s: tick N at start + N * period
+{
+   constexpr int64_t   period = 1000LL * PeriodUs ;
+   timespec            ts{} ;
+   clock_gettime(CLOCK_MONOTONIC, &ts) ;
+   const int64_t       start = ts.tv_sec * 1'000'000'000LL + ts.tv_nsec ;
+
+   for (int64_t n = 1 ; !stop.load(std::memory_order_relaxed) ; ++n) {
+      auto  due = start + n * period ;
+      ts = timespec{(time_t)(due / 1'000'000'000), (long)(due % 1'000'000'000)} ;
+      while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) ;
+      this->tick() ;
+   }
+}
+
+                                  // cWTimerStatic_:: private
+template <uint32_t Slots, uint32_t PeriodUs>
+typename cWTimerStatic_<Slots, PeriodUs>::Index_t
+cWTimerStatic_<Slots, PeriodUs>::alloc_node()                            // may throw: a new node
+{
+   if (_free == NIL)   this->free_node(this->new_node()) ;
+   auto  ix = _free ;
+   _free = _nodes[ix]._next ;
+   return ix ;
+}
+
+template <uint32_t Slots, uint32_t PeriodUs>
+void
+cWTimerStatic_<Slots, PeriodUs>::free_node(Index_t ix)                   // the next generation: stale handles
+{
+   auto& n = _nodes[ix] ;
+   _events[ix].reset(), ++n._gen, n._state = State_::FREE ;
+   n._prev = NIL, n._next = _free, _free = ix ;
+}
+
+template <uint32_t Slots, uint32_t PeriodUs>
+void
+cWTimerStatic_<Slots, PeriodUs>::link(Index_t ix, uint64_t when)
+{
+   auto& n = _nodes[ix] ;
+   auto  slot = when & MASK ;                                            // no division: a mask
+   auto& s = _slots[slot] ;
+   n._when = when, n._state = State_::LINKED, n._prev = s._tail, n._next = NIL ;
+   if (s._tail != NIL)   _nodes[s._tail]._next = ix ;
+   else                  s._head = ix ;
+   s._tail = ix ;
+   _busy[slot >> 6] |= 1ULL << (slot & 63) ;                             // the slot's bit: Slots < 64 too
+   ++_size ;
+}
+
+template <uint32_t Slots, uint32_t PeriodUs>
+void
+cWTimerStatic_<Slots, PeriodUs>::unlink(Index_t ix)
+{
+   auto& n = _nodes[ix] ;
+   auto  slot = n._when & MASK ;
+   auto& s = _slots[slot] ;
+   if (n._prev != NIL)   _nodes[n._prev]._next = n._next ;
+   else                  s._head = n._next ;
+   if (n._next != NIL)   _nodes[n._next]._prev = n._prev ;
+   else                  s._tail = n._prev ;
+   if (s._head == NIL)   _busy[slot >> 6] &= ~(1ULL << (slot & 63)) ;
+   n._prev = n._next = NIL ;
+   --_size ;
+}
+
+template <uint32_t Slots, uint32_t PeriodUs>
+uint64_t
+cWTimerStatic_<Slots, PeriodUs>::next_busy(uint64_t end) const&          // a word of the bitmap at a time
+{
+   const uint64_t   from = _now & MASK ;
+   for (uint64_t d = 0 ; d < Slots && _now + d < end ; ) {
+      auto  s = (from + d) & MASK ;
+      if (auto w = _busy[s >> 6] >> (s & 63))   return std::min(end, _now + d + __builtin_ctzll(w)) ;
+      d += std::min<uint64_t>(64 - (s & 63), Slots - s) ;                // the rest of the word: Slots < 64 too
+   }
+   return end ;                                                          // none: the wheel is empty
+}
+
+#endif // WT_STATIC_HPP
@@ -0,0 +1,222 @@
+// wt_tick_source.cpp: the tick sources, as defined in wt_tick_source.hpp
+//
+
+#include "wt_tick_source.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include <time.h>
+#include <errno.h>
+#include <unistd.h>
+#include <semaphore.h>
+#include <sys/timerfd.h>
+
+#if WTIMER_PTLIB
+extern "C" {
+#include "timerLib.h"                                                    // PTLib: a C library
+}
+#endif
+
+static int64_t
+mono_now_ns()
+{
+   timespec   ts{} ;
+   clock_gettime(CLOCK_MONOTONIC, &ts) ;
+   return ts.tv_sec * 1'000'000'000LL + ts.tv_nsec ;
+}
+
+static timespec
+ns_to_timespec(int64_t ns)
+{
+   return timespec{(time_t)(ns / 1'000'000'000), (long)(ns % 1'000'000'000)} ;
+}
+
+                                  // CONDVAR: steady_clock is CLOCK_MONOTONIC
+class cCondVarSource_ : public cWTickSource_ {
+  public:
+    int64_t wait_until(int64_t due_ns) override
+         { std::unique_lock<std::mutex>   lk{_m} ;
+           auto  tp = std::chrono::steady_clock::time_point{std::chrono::nanoseconds{due_ns}} ;
+           _cv.wait_until(lk, tp, [this, due_ns] { return _stop || mono_now_ns() >= due_ns ; }) ;
+           return 0 ; }
+    void interrupt() override
+         { { std::lock_guard<std::mutex> lk{_m} ; _stop = true ; }
+           _cv.notify_one() ; }
+    WTickSource_ kind() const& override { return WTickSource_::CONDVAR ; }
+
+  private:
+    std::mutex                _m{} ;
+    std::condition_variable   _cv{} ;
+    bool                      _stop{false} ;
+}; // class cCondVarSource_
+
+                                  // NANOSLEEP: no interrupt - stop() seen at the next tick
+class cNanoSleepSource_ : public cWTickSource_ {
+  public:
+    int64_t wait_until(int64_t due_ns) override
+         { auto  ts = ns_to_timespec(due_ns) ;
+           while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) ;
+           return 0 ; }
+    WTickSource_ kind() const& override { return WTickSource_::NANOSLEEP ; }
+}; // class cNanoSleepSource_
+
+                                  // TIMERFD: expirations at start + N * period exactly; interrupt() - an immediate one
+class cTimerFdSource_ : public cWTickSource_ {
+  public:
+    ~cTimerFdSource_() override { if (_fd >= 0)   close(_fd) ; }
+
+    bool arm(int64_t start_ns, int64_t period_ns) override
+         { _fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC) ;
+           itimerspec   its{ns_to_timespec(period_ns), ns_to_timespec(start_ns + period_ns)} ;
+           return _fd >= 0 && timerfd_settime(_fd, TFD_TIMER_ABSTIME, &its, nullptr) == 0 ; }
+    int64_t wait_until(int64_t due_ns) override
+         { uint64_t   expirations ;                                      // stale ones: the loop's late, read again
+           while (!_stop.load(std::memory_order_relaxed) && mono_now_ns() < due_ns)
+              if (read(_fd, &expirations, sizeof(expirations)) < 0 && errno != EINTR)   break ;
+           return 0 ; }
+    void interrupt() override
+         { _stop.store(true, std::memory_order_relaxed) ;
+           itimerspec   its{{0, 0}, {0, 1}} ;                            // relative: 1 nano from now, once
+           if (_fd >= 0)   timerfd_settime(_fd, 0, &its, nullptr) ; }
+    WTickSource_ kind() const& override { return WTickSource_::TIMERFD ; }
+
+  private:
+    std::atomic<int>    _fd{-1} ;                                        // interrupt(): maybe before arm()
+    std::atomic<bool>   _stop{false} ;
+}; // class cTimerFdSource_
+
+                                  // HYBRID: sleeps to 'spin' ahead, polls the clock the rest - vDSO, no syscall
+class cHybridSource_ : public cWTickSource_ {
+  public:
+    explicit cHybridSource_(int64_t spin_ns) : _spin_ns{std::max<int64_t>(spin_ns, 0)} {}
+
+    int64_t wait_until(int64_t due_ns) override
+         { auto  ts = ns_to_timespec(due_ns - _spin_ns) ;               // past already: returns at once
+           while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) ;
+           auto  from = mono_now_ns(), now = from ;
+           while (now < due_ns && !_stop.load(std::memory_order_relaxed))   cpu_relax(), now = mono_now_ns() ;
+           return now - from ; }
+    void interrupt() override { _stop.store(true, std::memory_order_relaxed) ; }
+    WTickSource_ kind() const& override { return WTickSource_::HYBRID ; }
+
+  private:
+    static void cpu_relax()                                              // the sibling hyper-thread: not starved
+         {
+#if defined(__x86_64__) || defined(__i386__)
+           __builtin_ia32_pause() ;
+#elif defined(__aarch64__)
+           asm volatile("yield" ::: "memory") ;
+#endif
+         }
+
+    const int64_t       _spin_ns ;
+    std::atomic<bool>   _stop{false} ;
+}; // class cHybridSource_
+
+#if WTIMER_PTLIB
+                                  // PTLIB: what its call-backs touch - pooled, never freed
+struct PTLibTimer_ {              // SIGEV_THREAD: a thread spawned before w_timer_delete() may enter after it
+  wTimer_t                _t{} ;                                         // ... lands here: a spurious sem_post() at most
+  sem_t                   _sem{} ;
+  std::atomic<uint32_t>   _inflight{0} ;                                 // call-backs entered, not returned
+  PTLibTimer_*            _next{nullptr} ;                               // the free list
+}; // struct PTLibTimer_
+
+static std::mutex     ptlib_m{} ;
+static PTLibTimer_*   ptlib_free{nullptr} ;
+
+static PTLibTimer_*                                                      // may throw: a new one
+ptlib_acquire()
+{
+   std::lock_guard<std::mutex>   lk{ptlib_m} ;
+   if (!ptlib_free) {
+      auto  pt = new PTLibTimer_{} ;
+      sem_init(&pt->_sem, 0, 0) ;
+      return pt ;
+   }
+   auto  pt = ptlib_free ;
+   ptlib_free = pt->_next ;
+   while (sem_trywait(&pt->_sem) == 0) ;                                 // the previous owner's posts
+   return pt ;
+}
+
+static void
+ptlib_release(PTLibTimer_* pt)
+{
+   std::lock_guard<std::mutex>   lk{ptlib_m} ;
+   pt->_next = ptlib_free, ptlib_free = pt ;
+}
+
+                                  // PTLIB: a call-back per expiration, on PTLib's threads - a sem_post() only
+class cPTLibSource_ : public cWTickSource_ {
+  public:
+    cPTLibSource_() : _pt{ptlib_acquire()} {}
+    ~cPTLibSource_() override
+    {
+       if (_armed)   w_timer_delete(&_pt->_t) ;                          // no new call-backs: the ones in flight ...
+       while (_pt->_inflight.load(std::memory_order_acquire) != 0)   std::this_thread::yield() ;   // ... drained
+       ptlib_release(_pt) ;
+    }
+
+    bool arm(int64_t start_ns, int64_t period_ns) override               // relative: its 1st due, a bit late at most
+         { auto  exp = std::max<int64_t>(start_ns + period_ns - mono_now_ns(), 1) ;
+           _armed = w_timer_initialize_ns(CLOCK_MONOTONIC, &_pt->_t, &cPTLibSource_::on_fire, _pt,
+                                          (uint64_t)exp, (uint64_t)period_ns, false, 0) ;
+           return _armed && w_timer_start(&_pt->_t) ; }
+    int64_t wait_until(int64_t due_ns) override                          // spurious posts: the clock re-checked
+         { while (!_stop.load(std::memory_order_relaxed) && mono_now_ns() < due_ns)
+              if (sem_wait(&_pt->_sem) < 0 && errno != EINTR)   break ;
+           return 0 ; }
+    void interrupt() override { _stop.store(true, std::memory_order_relaxed), sem_post(&_pt->_sem) ; }
+    WTickSource_ kind() const& override { return WTickSource_::PTLIB ; }
+
+  private:
+    static void on_fire(wTimer_t*, void* p)
+         { auto  pt = static_cast<PTLibTimer_*>(p) ;
+           pt->_inflight.fetch_add(1, std::memory_order_acq_rel) ;
+           sem_post(&pt->_sem) ;
+           pt->_inflight.fetch_sub(1, std::memory_order_release) ; }
+
+    PTLibTimer_*        _pt ;
+    bool                _armed{false} ;
+    std::atomic<bool>   _stop{false} ;
+}; // class cPTLibSource_
+#endif
+
+                                  // cWTickSource_::
+std::unique_ptr<cWTickSource_>
+cWTickSource_::make(WTickSource_ kind, int64_t spin_ns)
+{
+   try {
+      switch (kind) {
+         case WTickSource_::CONDVAR:   return std::make_unique<cCondVarSource_>() ;
+         case WTickSource_::NANOSLEEP: return std::make_unique<cNanoSleepSource_>() ;
+         case WTickSource_::TIMERFD:   return std::make_unique<cTimerFdSource_>() ;
+         case WTickSource_::HYBRID:    return std::make_unique<cHybridSource_>(spin_ns) ;
+#if WTIMER_PTLIB
+         case WTickSource_::PTLIB:     return std::make_unique<cPTLibSource_>() ;
+#endif
+         default:                      return nullptr ;                  // compiled out
+      }
+   } catch (...) { return nullptr ; }
+}
+
+                                  // external
+std::ostream& operator<< (std::ostream& os, WTickSource_ kind)
+{
+   switch (kind) {
+      case WTickSource_::CONDVAR:   return os << "condvar" ;
+      case WTickSource_::NANOSLEEP: return os << "nanosleep" ;
+      case WTickSource_::TIMERFD:   return os << "timerfd" ;
+      case WTickSource_::PTLIB:     return os << "ptlib" ;
+      case WTickSource_::HYBRID:    return os << "hybrid" ;
+   }
+   return os << "?" ;
+}
+
+// eof wt_tick_source.cpp
@@ -0,0 +1,46 @@
+// wt_tick_source.hpp: what wakes the Timer's thread up for its ticks - tick N is due at start + N * period
+//    - CONDVAR: a condition variable's timed wait, as of old - the default: stop() wakes it up
+//    - NANOSLEEP: clock_nanosleep(), TIMER_ABSTIME - no wake-up: stop() & the destructor wait up to a period
+//    - TIMERFD: a periodic timerfd on absolute deadlines, read() - the kernel counts the expirations
+//    - PTLIB: a PTLib periodic wTimer_t (its current backend, see w_timer_set_backend()) posting a semaphore
+//    - HYBRID: clock_nanosleep() to 'spin' before the deadline, then a busy wait on the clock (a pause per poll)
+//              - sub-100 micros ticks: the sleep's wake-up latency hidden, a core spent on it (see set_affinity())
+//    - all of them on CLOCK_MONOTONIC: wait_until() returns at 'due' or later, never earlier - or, interrupted
+//    - tickless & virtual modes: none used, see cWTimer_::tickless_loop() & advance()
+//    - WTIMER_PTLIB=0: PTLIB compiled out - make() @return nullptr for it
+//
+
+#ifndef WT_TICK_SOURCE_HPP
+#define WT_TICK_SOURCE_HPP
+
+#ifndef WTIMER_PTLIB
+#define WTIMER_PTLIB 1
+#endif
+
+#include <stdint.h>
+#include <memory>
+#include <ostream>
+
+
+enum class WTickSource_ : uint8_t { CONDVAR, NANOSLEEP, TIMERFD, PTLIB, HYBRID } ;
+
+class cWTickSource_ {             // owned by a cWTimer_: arm() & wait_until() - its thread, interrupt() - any
+  public:
+                                  // constructors & destructor
+    static std::unique_ptr<cWTickSource_> make(WTickSource_ kind,        // nullptr: not available
+                                               int64_t spin_ns = 0) ;    // HYBRID: its window, in nanos
+    virtual ~cWTickSource_() = default ;
+
+                                  // operations
+    virtual bool arm(int64_t /* start_ns */, int64_t /* period_ns */) { return true ; }   // before the 1st wait: CLOCK_MONOTONIC
+    virtual int64_t wait_until(int64_t due_ns) = 0 ;                     // ... due_ns: start + N * period, N > 0
+                                                                         //     @return nanos busy-waited: HYBRID
+    virtual void interrupt() {}                                          // stop(): out of wait_until(), if it can
+
+                                  // descriptive
+    virtual WTickSource_ kind() const& = 0 ;
+}; // class cWTickSource_
+
+std::ostream& operator<< (std::ostream& os, WTickSource_ kind) ;
+
+#endif // WT_TICK_SOURCE_HPP
@@ -0,0 +1,110 @@
+// wt_trace.hpp: asynchronous tracing of the ticks: binary records through a lock-free SPSC ring
+//    - the producer (Timer's thread): a fixed size record per tick - no formatting, no I/O, no locks
+//    - the consumer (a thread of its own): formats or persists them, see cWTimer_::set_trace()
+//    - full ring: the newest dropped or, the oldest overwritten - a sequence per slot tells the consumer
+//    - WTIMER_TRACE=0: compiled out
+//
+
+#ifndef WT_TRACE_HPP
+#define WT_TRACE_HPP
+
+#ifndef WTIMER_TRACE
+#define WTIMER_TRACE 1
+#endif
+
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <cstring>
+#include <type_traits>
+
+
+struct WTimerTraceRec_ {          // a tick's: 32 bytes
+  uint64_t   _tick{0} ;                                                  // absolute: rotation * slots + tick
+  int64_t    _woke_ns{0} ;                                               // CLOCK_MONOTONIC
+  int64_t    _jitter_ns{0} ;                                             // woken up late by
+  uint32_t   _work_ns{0} ;                                               // its work-load: saturated
+  uint16_t   _skipped{0} ;                                               // tickless: the empty ones before, saturated
+  uint8_t    _missed{0} ;                                                // the next one's deadline: passed
+  uint8_t    _tickless{0} ;
+}; // struct WTimerTraceRec_
+
+template <typename Rec>                                                  // Rec: trivially copyable
+class cWTimerTraceRing_ {
+  static_assert(std::is_trivially_copyable_v<Rec>, "cWTimerTraceRing_: records are copied as words") ;
+  static constexpr size_t   WORDS = (sizeof(Rec) + 7) / 8 ;
+
+  struct Slot_ {                  // seq: 2 * pos + 1 - being written, 2 * pos + 2 - written
+    std::atomic<uint64_t>   _seq{0} ;
+    std::atomic<uint64_t>   _w[WORDS] ;                                  // the record: read while written, maybe
+  }; // struct Slot_
+
+  public:
+                                  // constructors & destructor
+    explicit cWTimerTraceRing_(size_t capacity = 1024, bool overwrite = true)   // rounded up to a power of 2
+            : _mask{round_up(capacity) - 1}, _slots{std::make_unique<Slot_[]>(_mask + 1)}, _overwrite{overwrite} {}
+    cWTimerTraceRing_(const cWTimerTraceRing_&) = delete ;
+    cWTimerTraceRing_& operator= (const cWTimerTraceRing_&) = delete ;
+
+                                  // operations
+    bool push(const Rec& r)                                              // the producer: wait-free
+         { auto  h = _head.load(std::memory_order_relaxed) ;
+           if (!_overwrite && h - _tail.load(std::memory_order_acquire) > _mask)
+              return _dropped.store(_dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed), false ;
+           uint64_t   w[WORDS]{} ;
+           std::memcpy(w, &r, sizeof(Rec)) ;
+           auto& s = _slots[h & _mask] ;
+           s._seq.store(2 * h + 1, std::memory_order_relaxed) ;
+           std::atomic_thread_fence(std::memory_order_release) ;       // odd: before the words
+           for (size_t i = 0 ; i < WORDS ; ++i)   s._w[i].store(w[i], std::memory_order_relaxed) ;
+           s._seq.store(2 * h + 2, std::memory_order_release) ;
+           _head.store(h + 1, std::memory_order_release) ;
+           return true ; }
+
+    bool pop(Rec& r) ;                                                   // the consumer: the oldest one left
+
+                                  // descriptive
+    size_t   capacity() const& { return _mask + 1 ; }
+    uint64_t dropped() const& { return _dropped.load(std::memory_order_relaxed) ; }   // full: not overwriting
+    uint64_t lost() const& { return _lost.load(std::memory_order_relaxed) ; }         // ... overwritten unread
+
+  private:
+    static size_t round_up(size_t n) { size_t c = 2 ; while (c < n) c <<= 1 ; return c ; }
+
+    const size_t               _mask ;
+    std::unique_ptr<Slot_[]>   _slots ;
+    const bool                 _overwrite ;
+
+    alignas(64) std::atomic<uint64_t>   _head{0} ;                       // the producer's
+    std::atomic<uint64_t>               _dropped{0} ;
+    alignas(64) std::atomic<uint64_t>   _tail{0} ;                       // the consumer's
+    std::atomic<uint64_t>               _lost{0} ;
+}; // class cWTimerTraceRing_
+
+template <typename Rec>
+bool
+cWTimerTraceRing_<Rec>::pop(Rec& r)
+{
+   for ( ; ; ) {
+      auto  t = _tail.load(std::memory_order_relaxed) ;
+      auto  h = _head.load(std::memory_order_acquire) ;
+      if (t == h)   return false ;
+      if (h - t > _mask + 1) {                                           // lapped: the oldest ones are gone
+         _lost.store(_lost.load(std::memory_order_relaxed) + (h - _mask - 1 - t), std::memory_order_relaxed) ;
+         t = h - _mask - 1 ;
+      }
+
+      auto&     s = _slots[t & _mask] ;
+      uint64_t  w[WORDS] ;
+      auto      seq = s._seq.load(std::memory_order_acquire) ;
+      for (size_t i = 0 ; i < WORDS ; ++i)   w[i] = s._w[i].load(std::memory_order_relaxed) ;
+      std::atomic_thread_fence(std::memory_order_acquire) ;             // the words: before the 2nd read of seq
+      bool  ok = seq == 2 * t + 2 && s._seq.load(std::memory_order_relaxed) == seq ;
+
+      _tail.store(t + 1, std::memory_order_release) ;
+      if (ok)   return std::memcpy(&r, w, sizeof(Rec)), true ;
+      _lost.store(_lost.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed) ;   // overwritten meanwhile
+   }
+}
+
+#endif // WT_TRACE_HPP
@@ -10,20 +10,668 @@
 #include "Logger_helpers.hpp"
 
 #include "src/wheel_timer.hpp"
+#include "src/wt_group.hpp"
+#include "src/wt_static.hpp"
 
-void* func(void* p, size_t s) {
+#include <cstdlib>
+#include <new>
+#include <algorithm>
+#include <functional>
+#include <fstream>
+#include <string>
+
+                                  // counting heap allocations made by one (watched) thread
+static std::atomic<std::thread::id>   watched{} ;
+static std::atomic<size_t>            count_allocs{0} ;
+
+[[gnu::noinline]] static void* counted(size_t size, size_t align = 0) noexcept   // not inlined: nor paired with free()
+{                                                                        // ... by -Wmismatched-new-delete
+   if (watched.load(std::memory_order_relaxed) == std::this_thread::get_id())   ++count_allocs ;
+   void*  p = nullptr ;
+   if (align <= alignof(std::max_align_t))   p = std::malloc(size ? size : 1) ;
+   else if (posix_memalign(&p, align, size ? size : 1) != 0)   p = nullptr ;
+   return p ;
+}
+[[gnu::noinline]] static void uncounted(void* p) noexcept { std::free(p) ; }
+
+void* operator new(size_t size)
+{ if (void* p = counted(size))   return p ; throw std::bad_alloc{} ; }
+void* operator new[](size_t size)
+{ if (void* p = counted(size))   return p ; throw std::bad_alloc{} ; }
+void* operator new(size_t size, std::align_val_t al)
+{ if (void* p = counted(size, (size_t)al))   return p ; throw std::bad_alloc{} ; }
+void* operator new[](size_t size, std::align_val_t al)
+{ if (void* p = counted(size, (size_t)al))   return p ; throw std::bad_alloc{} ; }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return counted(size) ; }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return counted(size) ; }
+
+void operator delete(void* p) noexcept { uncounted(p) ; }
+void operator delete[](void* p) noexcept { uncounted(p) ; }
+void operator delete(void* p, size_t) noexcept { uncounted(p) ; }
+void operator delete[](void* p, size_t) noexcept { uncounted(p) ; }
+void operator delete(void* p, std::align_val_t) noexcept { uncounted(p) ; }
+void operator delete[](void* p, std::align_val_t) noexcept { uncounted(p) ; }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { uncounted(p) ; }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { uncounted(p) ; }
+void operator delete(void* p, const std::nothrow_t&) noexcept { uncounted(p) ; }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { uncounted(p) ; }
+
+void* func(void*, size_t) {
    Log_to(0, "> from WTImerCB_t: @ ", LOG_TIME_LAPSE(Log_start())) ;
    return nullptr ;
 }
 
+void* watch_me(void*, size_t) {                            // inlay: runs on the Timer's thread
+   watched.store(std::this_thread::get_id()) ;
+   return nullptr ;
+}
+
+void* do_nothing(void*, size_t) { return nullptr ; }
+
+bool test_steady_state_allocations()                           // ticking, firing, relinking: no heap allocations
+{
+   cWTimer_   timer{16, 2, 0, true, "Alloc_Test", 2} ;          // 16 slots, 2 millis, hierarchical, histograms
+   timer.log_ticks(false), timer.reserve(2048) ;
+
+   std::atomic<uint64_t>   sink{0} ;                            // lambdas' state: kept in place
+   timer.register_event(cWTimerEvent_{1, true, watch_me, true}) ;
+   for (uint32_t i = 0 ; i < 1000 ; ++i) {                      // recurrent: inlay & dispatched, one-time: far away
+      timer.register_event(cWTimerEvent_{1 + i % 37, true, do_nothing, i % 3 != 0}) ;
+      timer.register_event(cWTimerEvent_{1 + i % 23, true, [p = &sink, i] { p->fetch_add(i) ; }, i % 2 != 0}) ;
+      timer.register_event(cWTimerEvent_{100000 + i, false, do_nothing, true}) ;
+   }
+   timer.start() ;
+   std::this_thread::sleep_for(std::chrono::milliseconds(200)) ;   // warm-up: the posted ones drained
+   count_allocs = 0 ;
+   std::this_thread::sleep_for(std::chrono::seconds(1)) ;
+   size_t   count = count_allocs ;
+   timer.stop() ;
+
+   Log_to(0, "> steady state: ", count, " heap allocations by the Timer's thread in 1s: ", count == 0 ? "OK" : "FAILED") ;
+   watched = std::thread::id{} ;
+   return count == 0 ;
+}
+
+bool test_tickless()                                          // sleeps to the next non-empty slot: same firing ticks
+{
+   using namespace std::chrono ;
+   cWTimer_   timer{16, 2, 0, false, "Tickless_Test", 2} ;     // 16 slots, 2 millis, hierarchical
+   timer.log_ticks(false), timer.set_tickless(true) ;
+
+   std::atomic<uint32_t>   fired{0} ;
+   std::atomic<int64_t>    lapse{-1} ;
+   timer.register_event(cWTimerEvent_{50, true, [&fired] { ++fired ; }, true}) ;   // each 100 millis
+   timer.start() ;
+
+   std::this_thread::sleep_for(milliseconds(333)) ;             // the Timer: asleep, to be woken up
+   auto   posted = steady_clock::now() ;
+   timer.register_event(cWTimerEvent_{5, false, [&lapse, posted]
+                        { lapse = duration_cast<milliseconds>(steady_clock::now() - posted).count() ; }, true}) ;
+   std::this_thread::sleep_for(milliseconds(1000 - 333)) ;
+   timer.stop() ;
+
+   bool   ok = fired >= 9 && fired <= 10 && lapse >= 8 && lapse <= 20 ;   // 5 ticks after the next one
+   Log_to(0, "> tickless: fired ", fired.load(), " times in 1s, posted 5 ticks ahead: fired in ", lapse.load(),
+             "ms: ", ok ? "OK" : "FAILED") ;
+   return ok ;
+}
+
+bool test_histogram()                                         // percentiles within 1/32; take(): no record lost
+{
+   cWTimerHistogram_   h ;
+   for (int64_t v = 1 ; v <= 100'000 ; ++v)   h.record(v) ;
+   auto   s = h.snapshot() ;
+   auto   within = [](uint64_t got, double want) { return got >= want && got <= want * (1 + 1.0 / 32) ; } ;
+   bool   ok = s._count == 100'000 && s._max == 100'000 && within(s.percentile(50), 50'000)
+               && within(s.percentile(99), 99'000) && within(s.percentile(99.9), 99'900) && s.percentile(100) == 100'000 ;
+
+   constexpr uint64_t   N = 1'000'000 ;
+   h.reset() ;
+   std::atomic<bool>    done{false} ;
+   auto   start = std::chrono::steady_clock::now() ;
+   std::thread   writer{[&h, &done] { for (uint64_t i = 0 ; i < N ; ++i)   h.record(i & 0xffff) ; done = true ; }} ;
+   uint64_t   taken = 0 ;
+   while (!done)   taken += h.take()._count ;
+   writer.join() ;
+   auto   lapse = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() ;
+   taken += h.take()._count ;
+   ok = ok && taken == N ;
+
+   Log_to(0, "> histogram: ", s, ", ", taken, " of ", N, " records taken concurrently (",
+             lapse / N, " ns/record): ", ok ? "OK" : "FAILED") ;
+   return ok ;
+}
+
+bool test_stats()                                             // a monitoring thread: consistent snapshots, no locks
+{
+   cWTimer_   timer{16, 1, 0, false, "Stats_Test", 2} ;        // 16 slots, 1 milli, hierarchical
+   timer.log_ticks(false) ;
+
+   std::atomic<uint64_t>   count{0} ;
+   for (uint32_t i = 0 ; i < 100 ; ++i)                         // recurrent only: fired == rescheduled, always
+      timer.register_event(cWTimerEvent_{1 + i % 40, true, [&count] { ++count ; }, true}) ;
+   timer.start() ;
+
+   size_t         reads = 0, torn = 0 ;
+   WTimerStats_   last{} ;
+   for (auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(500) ; std::chrono::steady_clock::now() < end ; ++reads) {
+      auto   st = timer.stats() ;
+      if (st._fired != st._rescheduled || st._ticks < last._ticks || st._fired < last._fired
+          || (st._ticks > 0 && st._scheduled + st._posted != 100))   ++torn ;
+      last = st ;
+   }
+   timer.stop() ;
+   std::this_thread::sleep_for(std::chrono::milliseconds(10)) ;
+
+   auto   st = timer.stats() ;
+   auto   pop = timer.population() ;
+   size_t in_slots = 0 ;
+   for (auto n : pop)   in_slots += n ;
+   bool   ok = torn == 0 && st._fired == count && st._scheduled == in_slots && st._max_depth > 0 ;
+   Log_to(0, "> ", st, ": ", reads, " reads, ", torn, " inconsistent, ", count.load(), " fired by the call-backs: ",
+             ok ? "OK" : "FAILED") ;
+   return ok ;
+}
+
+bool test_virtual_clock()                                      // the same load: the same ticks, order & counts as ticking
+{
+   using Fired = std::vector<std::pair<uint64_t, uint32_t>> ;   // {tick, event}
+   auto   run = [](bool virt, uint64_t ticks) {
+      Fired      fired ;                                        // outlives the Timer
+      cWTimer_   timer{16, 1, 0, false, virt ? "Virtual" : "Real", 2} ;
+      fired.reserve(100'000) ;
+      timer.log_ticks(false), timer.set_virtual(virt) ;
+      for (uint32_t i = 0 ; i < 2000 ; ++i)                     // recurrent & one-time, over a few levels
+         timer.register_event(cWTimerEvent_{1 + (i * 7919) % 300, i % 3 != 0,
+                                            [&timer, &fired, i] { fired.emplace_back(timer.now(), i) ; }, true}) ;
+      timer.start() ;
+      if (virt)   timer.advance(ticks) ;
+      else while (timer.stats()._ticks < ticks + 5)   std::this_thread::sleep_for(std::chrono::milliseconds(10)) ;
+      timer.stop() ;
+      std::this_thread::sleep_for(std::chrono::milliseconds(5)) ;
+      while (!fired.empty() && fired.back().first >= ticks)   fired.pop_back() ;
+      return fired ;
+   } ;
+   auto   real = run(false, 400) ;
+   auto   simulated = run(true, 400) ;
+
+   cWTimer_   timer{4096, 1, 0, false, "Virtual_Hour", 2} ;     // a simulated hour: 1 milli ticks
+   timer.log_ticks(false), timer.set_virtual(true), timer.reserve(100'000) ;
+   for (uint32_t i = 0 ; i < 100'000 ; ++i)   timer.register_event(cWTimerEvent_{1000 + (i * 7919) % 59'000, true, do_nothing}) ;
+   timer.start() ;
+   auto   start = std::chrono::steady_clock::now() ;
+   auto   count = timer.advance(3'600'000) ;
+   auto   lapse = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() ;
+
+   bool   ok = !real.empty() && real == simulated ;
+   Log_to(0, "> virtual clock: ", simulated.size(), " firings, as ticking: ", real.size(), "; a simulated hour of 100000 timers: ",
+             count, " fired in ", lapse, "s: ", ok ? "OK" : "FAILED") ;
+   return ok ;
+}
+
+bool test_overrun()                                           // a 10 millis burst on a 1 milli wheel: per policy
+{
+   auto   burst = [](WTOverrun_ policy) {
+      std::atomic<uint64_t>   fires{0}, misses{0} ;
+      cWTimer_   timer{16, 1, 0, false, "Overrun_Test", 2} ;
+      timer.log_ticks(false), timer.set_overrun(policy) ;
+      timer.register_event(cWTimerEvent_{1, true, [&timer, &fires, &misses] { ++fires, misses += timer.missed() ; }, true}) ;
+      timer.register_event(cWTimerEvent_{20, false, [] { std::this_thread::sleep_for(std::chrono::milliseconds(10)) ; }, true}) ;
+      timer.start() ;
+      std::this_thread::sleep_for(std::chrono::milliseconds(100)) ;
+      timer.stop() ;
+      std::this_thread::sleep_for(std::chrono::milliseconds(5)) ;
+      auto   st = timer.stats() ;
+      return std::make_tuple(st, fires.load(), misses.load()) ;
+   } ;
+
+   auto [cst, cfires, cmisses] = burst(WTOverrun_::CATCH_UP) ;  // every tick run: fired each one
+   auto [sst, sfires, smisses] = burst(WTOverrun_::SKIP_AHEAD) ; // ... fired once for the late ones
+   bool   ok = cst._caught_up >= 5 && cmisses == 0 && cfires + 1 >= cst._ticks
+               && sst._skips >= 1 && smisses >= 5 && smisses == sst._coalesced && sfires + smisses + 1 >= sst._ticks ;
+
+   cWTimer_   timer{16, 1, 0, false, "Spread_Test", 2} ;       // 100 due at once, 10 per tick: virtual clock
+   timer.log_ticks(false), timer.set_virtual(true), timer.set_overrun(WTOverrun_::SPREAD, 10) ;
+   for (uint32_t i = 0 ; i < 100 ; ++i)   timer.register_event(cWTimerEvent_{3, false, do_nothing}) ;
+   timer.start() ;
+   uint64_t   most = 0, fired = 0 ;
+   for (int t = 0 ; t < 20 ; ++t) { auto f = timer.advance(1) ; most = std::max(most, f), fired += f ; }
+   auto   pst = timer.stats() ;
+   ok = ok && most == 10 && fired == 100 && pst._over_budget == 9 && pst._deferred == 450 ;
+
+   Log_to(0, "> overrun: catch up: ", cst, "; skip ahead: ", sst, " fired ", sfires, " + missed ", smisses,
+             "; spread: ", pst, ": ", ok ? "OK" : "FAILED") ;
+   return ok ;
+}
+
+bool test_trace()                                             // SPSC ring: in order, each record read or counted lost
+{
+   bool   ok = true ;
+   for (bool overwrite : {true, false}) {
+      constexpr uint64_t   N = 1'000'000 ;
+      cWTimerTraceRing_<WTimerTraceRec_>   ring{256, overwrite} ;
+      std::atomic<bool>   done{false} ;
+      uint64_t            read = 0, last = 0, disorder = 0 ;
+      std::thread   consumer{[&] {
+         WTimerTraceRec_   r ;
+         for (bool fin = false ; !fin ; ) {
+            fin = done.load() ;
+            while (ring.pop(r)) { if (read++ && r._tick <= last) ++disorder ; last = r._tick ; }
+         }
+      }} ;
+      auto   start = std::chrono::steady_clock::now() ;
+      for (uint64_t i = 0 ; i < N ; ++i)   ring.push(WTimerTraceRec_{i, (int64_t)i}) ;
+      auto   lapse = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() ;
+      done = true ;
+      consumer.join() ;
+
+      bool   fine = disorder == 0 && read + ring.lost() + ring.dropped() == N ;
+      Log_to(0, "> trace ring (", overwrite ? "overwrite" : "drop", "): ", lapse / N, " ns/push, read ", read,
+                ", lost ", ring.lost(), ", dropped ", ring.dropped(), ": ", fine ? "OK" : "FAILED") ;
+      ok = ok && fine ;
+   }
+
+   std::atomic<uint64_t>   records{0}, ticks{0} ;               // a Timer's: to a sink, off its thread
+   {
+      cWTimer_   timer{16, 1, 0, false, "Trace_Test", 2} ;
+      timer.set_trace(64, true, [&records](const WTimerTraceRec_&) { ++records ; }) ;
+      timer.start() ;
+      std::this_thread::sleep_for(std::chrono::milliseconds(100)) ;
+      timer.stop() ;
+      std::this_thread::sleep_for(std::chrono::milliseconds(5)) ;
+      ticks = timer.stats()._ticks ;
+   }
+   ok = ok && records == ticks && ticks > 0 ;
+   Log_to(0, "> trace: ", records.load(), " records of ", ticks.load(), " ticks: ", ok ? "OK" : "FAILED") ;
+   return ok ;
+}
+
+bool test_static()                                             // the same load: the same firings as cWTimer_'s
+{
+   using Fired = std::vector<std::pair<uint64_t, uint32_t>> ;   // {tick, event}: sorted, a tick's order may differ
+   auto   load = [](auto& timer, Fired& fired) {
+      for (uint32_t i = 0 ; i < 2000 ; ++i)
+         timer.register_event(cWTimerEvent_{1 + (i * 7919) % 300, i % 3 != 0,
+                                            [&timer, &fired, i] { fired.emplace_back(timer.now(), i) ; }, true}) ;
+   } ;
+   Fired   expected, fired ;
+   {
+      cWTimer_   timer{16, 1, 0, false, "Static_Ref", 2} ;
+      timer.log_ticks(false), timer.set_virtual(true) ;
+      load(timer, expected) ;
+      timer.start() ;
+      timer.advance(400) ;
+   }
+   cWTimerStatic_<16, 1000>   wheel ;
+   load(wheel, fired) ;
+   wheel.advance(400) ;
+   std::sort(expected.begin(), expected.end()), std::sort(fired.begin(), fired.end()) ;
+   bool   ok = !fired.empty() && fired == expected ;
+
+   cWTimerStatic_<16, 1000>   w ;                               // cancel & reschedule: by handle, in call-backs too
+   int    a = 0, b = 0 ;
+   WTimerHandle_   hb ;
+   auto   ha = w.register_event(cWTimerEvent_{2, true, [&] { ++a, w.cancel(hb) ; }, true}) ;
+   hb = w.register_event(cWTimerEvent_{3, true, [&b] { ++b ; }, true}) ;
+   w.advance(10) ;                                             // a: at 2, 4, 6, 8; b: cancelled at 2, never fired
+   ok = ok && a == 4 && b == 0 && !w.cancel(hb) && w.reschedule(ha, 5) && w.size() == 1 ;
+   w.advance(6) ;                                              // ... at 15
+   ok = ok && a == 5 && w.cancel(ha) && w.size() == 0 ;
+
+   cWTimerStatic_<16, 1000>   self ;                            // by its own call-back: rescheduled, then cancelled
+   int    d = 0, e = 0 ;
+   WTimerHandle_   hd, hz ;
+   hd = self.register_event(cWTimerEvent_{2, true, [&] { ++d, self.reschedule(hd, 3), self.cancel(hd) ; }, true}) ;
+   self.advance(5) ;                                           // d: at 2 only - its node freed once
+   auto   h1 = self.register_event(cWTimerEvent_{1, false, [&e] { ++e ; }, true}) ;
+   auto   h2 = self.register_event(cWTimerEvent_{1, false, [&e] { ++e ; }, true}) ;
+   self.advance(3) ;
+   ok = ok && d == 1 && h1._ix != h2._ix && e == 2 && self.size() == 0 && !self.cancel(hd) ;
+   std::vector<uint64_t>   at ;                                 // ... rescheduled in 0 ticks: at the next one
+   auto   from = self.now() ;
+   hz = self.register_event(cWTimerEvent_{4, false, [&] {
+           at.push_back(self.now() - from) ;
+           if (at.size() == 1)   self.reschedule(hz, 0) ;
+        }, true}) ;
+   self.advance(10) ;
+   ok = ok && at == std::vector<uint64_t>{4, 5} && self.size() == 0 ;
+
+   cWTimerStatic_<16, 1000>   wrap ;                            // advance(): empty ticks skipped across rotations
+   int    c = 0 ;
+   wrap.advance(21) ;
+   wrap.register_event(cWTimerEvent_{15, false, [&c] { ++c ; }, true}) ;   // due at 36: slot 4, a rotation on
+   auto   wrapped = wrap.advance(40) ;
+   ok = ok && wrapped == 1 && c == 1 && wrap.size() == 0 && wrap.now() == 61 ;
+   for (uint32_t p : {1u, 15u, 16u, 17u, 33u}) {               // ... & more: each one at its tick
+      uint64_t   at = 0 ;
+      wrap.register_event(cWTimerEvent_{p, false, [&wrap, &at] { at = wrap.now() ; }, true}) ;
+      auto   from = wrap.now() ;
+      wrap.advance(50) ;
+      ok = ok && at == from + p ;
+   }
+
+   cWTimerStatic_<4096, 1000>   hour ;                          // a simulated hour: vs cWTimer_'s, see test_virtual_clock()
+   hour.reserve(100'000) ;
+   for (uint32_t i = 0 ; i < 100'000 ; ++i)   hour.register_event(cWTimerEvent_{1000 + (i * 7919) % 59'000, true, do_nothing}) ;
+   auto   start = std::chrono::steady_clock::now() ;
+   auto   count = hour.advance(3'600'000) ;
+   auto   lapse = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() ;
+
+   Log_to(0, "> static wheel: ", fired.size(), " firings, as cWTimer_: ", expected.size(), "; a simulated hour of 100000 timers: ",
+             count, " fired in ", lapse, "s: ", ok ? "OK" : "FAILED") ;
+   return ok ;
+}
+
+bool test_slack()                                              // "roughly N ticks": within [N, N + slack], on fewer ticks
+{
+   auto   run = [](bool slack) {
+      cWTimer_   timer{4096, 1, 0, false, "Slack_Test", 2} ;
+      std::vector<uint64_t>   at(2000) ;
+      timer.log_ticks(false), timer.set_virtual(true) ;
+      for (uint32_t i = 0 ; i < 2000 ; ++i) {                   // slack: an 8th of the period
+         uint32_t   period = 100 + (i * 7919) % 3900 ;
+         timer.register_event(cWTimerEvent_{period, false, [&timer, &at, i] { at[i] = timer.now() ; }, true, slack ? period / 8 : 0}) ;
+      }
+      timer.start() ;
+      timer.advance(5000) ;
+      bool   ok = true ;
+      for (uint32_t i = 0 ; i < 2000 ; ++i) {
+         uint32_t   period = 100 + (i * 7919) % 3900 ;
+         ok = ok && at[i] >= period && at[i] <= period + (slack ? period / 8 : 0) ;
+      }
+      return std::make_pair(ok, timer.stats()._ticks) ;
+   } ;
+   auto [exact_ok, exact] = run(false) ;
+   auto [slack_ok, slacked] = run(true) ;
+   bool   ok = exact_ok && slack_ok && slacked * 4 < exact ;
+   Log_to(0, "> slack: ticks run for 2000 timers, exact ", exact, ", with slack ", slacked, ": ", ok ? "OK" : "FAILED") ;
+   return ok ;
+}
+
+bool test_tick_sources()                                        // each one: a tick per period, no drift, stop() honoured
+{
+   bool   ok = true ;
+   for (auto src : {WTickSource_::CONDVAR, WTickSource_::NANOSLEEP, WTickSource_::TIMERFD, WTickSource_::PTLIB}) {
+      std::atomic<uint64_t>   fired{0} ;
+      cWTimer_   timer{64, 1, 0, true, "Source_Test", 0, src} ;
+      timer.log_ticks(false) ;
+      timer.register_event(cWTimerEvent_{1, true, [&fired] { fired.fetch_add(1, std::memory_order_relaxed) ; }, true}) ;
+      auto   start = std::chrono::steady_clock::now() ;
+      if (!timer.start()) { Log_to(0, "> tick source ", src, ": not started - FAILED") ; ok = false ; continue ; }
+      std::this_thread::sleep_for(std::chrono::milliseconds(200)) ;
+      timer.stop() ;
+      auto   ticks = timer.stats()._ticks ;
+      auto   lapse = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count() ;
+      auto   jitter = timer.debug()._jitter.snapshot() ;
+      bool   src_ok = ticks + 20 >= (uint64_t)lapse && ticks <= (uint64_t)lapse && fired.load() + 1 >= ticks ;
+      Log_to(0, "> tick source ", src, ": ", ticks, " ticks in ", lapse, " millis, jitter p50 ", jitter.percentile(50) / 1000.0,
+                " p99 ", jitter.percentile(99) / 1000.0, " micros: ", src_ok ? "OK" : "FAILED") ;
+      ok = ok && src_ok ;
+   }
+   auto   start = std::chrono::steady_clock::now() ;           // the default one: out of a 1s sleep by stop()
+   {  cWTimer_   slow{8, 1000, 0, false, "Stop_Test"} ;
+      slow.log_ticks(false), slow.start() ;
+      std::this_thread::sleep_for(std::chrono::milliseconds(10)) ;
+   }
+   auto   lapse = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count() ;
+   Log_to(0, "> tick source ", WTickSource_::CONDVAR, " (default): a 1s period stopped & joined in ", lapse, " millis: ",
+             lapse < 200 ? "OK" : "FAILED") ;
+   return ok && lapse < 200 ;
+}
+
+bool test_hybrid()                                             // 100 micros ticks: sleep, then spin - the jitter as measured
+{
+   using namespace std::chrono_literals ;
+   std::atomic<uint64_t>   fired{0} ;
+   cWTimer_   timer{1024, 100us, true, "Hybrid_Test"} ;         // HYBRID: by default with micros
+   timer.log_ticks(false), timer.set_spin(60us) ;
+   timer.register_event(cWTimerEvent_{1, true, [&fired] { fired.fetch_add(1, std::memory_order_relaxed) ; }, true}) ;
+   auto   start = std::chrono::steady_clock::now() ;
+   if (!timer.start()) { Log_to(0, "> hybrid: not started - FAILED") ; return false ; }
+   std::this_thread::sleep_for(200ms) ;
+   timer.stop() ;
+   auto   ticks = timer.stats()._ticks ;
+   auto   expected = (uint64_t)((std::chrono::steady_clock::now() - start) / 100us) ;
+   auto   jitter = timer.debug()._jitter.snapshot() ;
+   auto   spin = timer.debug()._spin.snapshot() ;
+   bool   ok = ticks + expected / 10 >= expected && ticks <= expected && fired.load() + 1 >= ticks
+                && spin._count == jitter._count ;
+   Log_to(0, "> hybrid: ", ticks, " ticks of 100 micros (", expected, " due), jitter p50 ", jitter.percentile(50) / 1000.0,
+             " p99 ", jitter.percentile(99) / 1000.0, " max ", jitter._max / 1000.0, " micros, spun p50 ",
+             spin.percentile(50) / 1000.0, " micros: ", ok ? "OK" : "FAILED") ;
+   return ok ;
+}
+
+bool test_group()                                              // the shards' stats: summed, their lateness merged
+{
+   cWTimerGroup_   group{{-1, -1}, 64, 1, 0, "Group_Test", true} ;
+   group.log_ticks(false) ;
+   for (uint64_t k = 0 ; k < 100 ; ++k)   group.register_event(k, cWTimerEvent_{1 + (uint32_t)k % 7, true, do_nothing, true}) ;
+   group.start() ;
+   std::this_thread::sleep_for(std::chrono::milliseconds(100)) ;
+   group.stop() ;
+   std::this_thread::sleep_for(std::chrono::milliseconds(10)) ;  // the last ticks: published
+
+   auto   st = group.stats() ;
+   auto   s0 = group.shard(0).stats(), s1 = group.shard(1).stats() ;
+   bool   ok = st._registered == 100 && st._timers._scheduled == 100 && st._timers._ticks == s0._ticks + s1._ticks
+               && st._timers._fired == s0._fired + s1._fired && st._timers._fired > 0
+               && st._lateness._count == st._timers._fired ;
+   Log_to(0, "> group: ", group, ": ", ok ? "OK" : "FAILED") ;
+   return ok ;
+}
+
+bool test_bulk_registration()                                 // register_events(): as a register_event() loop, posted & in place
+{
+   constexpr uint32_t   N = 10'000 ;
+   cWTimer_   loop{256, 1, 0, false, "Loop", 2}, bulk{256, 1, 0, false, "Bulk", 2} ;
+   std::vector<WTimerHandle_>   hl, hb ;
+   auto   batch = [](uint32_t from) {                           // recurrent & one-time, near & far
+      std::vector<cWTimerEvent_>   evs ;
+      for (uint32_t i = from ; i < from + N ; ++i)   evs.emplace_back(1 + (i * 7919) % 5000, i % 3 != 0, do_nothing, true) ;
+      return evs ;
+   } ;
+   auto   both = [&](uint32_t from) {
+      for (auto& ev : batch(from))   hl.push_back(loop.register_event(std::move(ev))) ;
+      auto   hs = bulk.register_events(batch(from)) ;
+      hb.insert(hb.end(), hs.begin(), hs.end()) ;
+   } ;
+   for (auto t : {&loop, &bulk})   t->log_ticks(false), t->set_virtual(true), t->start() ;
+
+   both(0) ;                                                    // not the Timer's thread yet: posted
+   loop.advance(1), bulk.advance(1) ;                           // ... drained; the Timer's from now on
+   both(N) ;                                                    // in place
+   bool   ok = hl.size() == 2 * N && hb.size() == 2 * N
+               && std::all_of(hb.begin(), hb.end(), [](const WTimerHandle_& h) { return (bool)h ; }) ;
+   for (size_t i = 0 ; i < hl.size() ; i += 4)                  // the handles: as good as the loop's
+      ok = ok && loop.cancel(hl[i]) == bulk.cancel(hb[i]) && loop.reschedule(hl[i + 1], 7) == bulk.reschedule(hb[i + 1], 7) ;
+
+   auto   fl = loop.advance(20'000), fb = bulk.advance(20'000) ;
+   auto   sl = loop.stats(), sb = bulk.stats() ;
+   ok = ok && fl == fb && fl > 0 && sl._fired == sb._fired && sl._rescheduled == sb._rescheduled
+           && sl._scheduled == sb._scheduled ;
+
+   cWTimer_   posted{64, 1, 0, false, "Refused", 2} ;           // recurrent, dispatched & move-only: refused, as by
+   std::vector<cWTimerEvent_>   mixed ;                         // ... register_event() - an empty handle in its place
+   mixed.emplace_back(3, true, do_nothing) ;
+   mixed.emplace_back(3, true, [p = std::make_unique<int>(0)] { ++*p ; }) ;
+   mixed.emplace_back(3, false, [p = std::make_unique<int>(0)] { ++*p ; }) ;
+   auto   hm = posted.register_events(std::move(mixed)) ;
+   bool   refused = hm.size() == 3 && hm[0] && !hm[1] && hm[2]
+                    && !posted.register_event(cWTimerEvent_{3, true, [p = std::make_unique<int>(0)] { ++*p ; }}) ;
+   ok = ok && refused ;
+   Log_to(0, "> bulk registration: ", hb.size(), " handles, ", fb, " fired, ", sb._scheduled, " scheduled - as the loop's ",
+             hl.size(), ", ", fl, ", ", sl._scheduled, "; move-only & recurrent refused ", refused, ": ", ok ? "OK" : "FAILED") ;
+   return ok ;
+}
+
+bool test_handles()                                            // stale ones refused; cancel/reschedule of one in flight
+{
+   cWTimer_   timer{16, 1, 0, false, "Handle_Test", 2} ;
+   timer.log_ticks(false), timer.set_virtual(true), timer.start(), timer.advance(0) ;   // this thread: the Timer's
+
+   auto   once = timer.register_event(cWTimerEvent_{2, false, do_nothing, true}) ;
+   timer.advance(3) ;                                           // fired: its node back to the pool
+   auto   reused = timer.register_event(cWTimerEvent_{2, false, do_nothing, true}) ;
+   bool   stale = !timer.cancel(once) && !timer.reschedule(once, 1)
+                  && reused._ix == once._ix && reused._gen != once._gen   // the same node, not the same event
+                  && timer.cancel(reused) && !timer.cancel(reused)
+                  && !timer.cancel(WTimerHandle_{UINT32_MAX - 1, 0}) && timer.advance(5) == 0 ;
+
+   std::vector<uint64_t>   at ;                                 // the ticks it fired at
+   WTimerHandle_           h{} ;
+   std::atomic<int>        step{0} ;                            // in flight: 1 - to be acted upon, 2 - done
+   auto   in_flight = [&](std::function<void()> act, uint32_t period) {   // by another thread, while its call-back runs
+      at.clear(), step = 0 ;
+      std::thread   other{[&] { while (step != 1) std::this_thread::yield() ; act() ; step = 2 ; }} ;
+      h = timer.register_event(cWTimerEvent_{period, true, [&] {
+             at.push_back(timer.now()) ;
+             if (at.size() == 1) { step = 1 ; while (step != 2)   std::this_thread::yield() ; }
+          }, true}) ;
+      auto  from = timer.now() ;
+      timer.advance(40), other.join() ;
+      for (auto& t : at)   t -= from ;
+      timer.cancel(h) ;
+   } ;
+   auto   by_owner = [&](std::function<void()> act, uint32_t period) {     // ... by its own call-back
+      at.clear() ;
+      h = timer.register_event(cWTimerEvent_{period, true, [&, act] { at.push_back(timer.now()) ; if (at.size() == 1) act() ; }, true}) ;
+      auto  from = timer.now() ;
+      timer.advance(40) ;
+      for (auto& t : at)   t -= from ;
+      timer.cancel(h) ;
+   } ;
+   using v = std::vector<uint64_t> ;
+   bool   ok = stale ;
+   in_flight([&] { ok = ok && timer.cancel(h) && !timer.cancel(h) ; }, 4) ;              // F_CANCEL, queued
+   ok = ok && at == v{4} ;
+   in_flight([&] { ok = ok && timer.reschedule(h, 10) && !timer.cancel(WTimerHandle_{h._ix, h._gen + 1}) ; }, 4) ;
+   ok = ok && at == v{4, 15, 19, 23, 27, 31, 35, 39} ;                                   // F_RESCHED, queued: from tick 5
+   in_flight([&] { ok = ok && timer.reschedule(h, 10) && timer.cancel(h) && !timer.reschedule(h, 1) ; }, 4) ;
+   ok = ok && at == v{4} ;                                                               // ... then cancelled
+   by_owner([&] { ok = ok && timer.cancel(h) ; }, 4) ;                                   // F_CANCEL, settled()
+   ok = ok && at == v{4} ;
+   by_owner([&] { ok = ok && timer.reschedule(h, 10) ; }, 4) ;                           // F_RESCHED, settled()
+   ok = ok && at == v{4, 14, 18, 22, 26, 30, 34, 38} ;
+
+   Log_to(0, "> handles: stale ones refused ", stale, "; cancel & reschedule of one in flight, by another thread "
+             "& by its call-back: ", ok ? "OK" : "FAILED") ;
+   return ok ;
+}
+
+bool test_posting()                                            // MPSC: N producers, each posted event fired once, none lost;
+                                                               // ... stats: registrations as posted, not requests
+{
+   constexpr uint32_t   P = 4, K = 20'000 ;
+   cWTimer_   timer{64, 1, 0, false, "Posting_Test", 2} ;
+   timer.log_ticks(false), timer.set_virtual(true), timer.start(), timer.advance(0) ;   // this thread: the Timer's
+
+   std::vector<uint32_t>   fired(P * K, 0) ;                    // the Timer's thread only
+   std::atomic<uint32_t>   refused{0}, done{0} ;
+   auto   event = [&](uint32_t j) { return cWTimerEvent_{1 + j % 5, false, [c = &fired[j]] { ++*c ; }, true} ; } ;
+   std::vector<std::thread>   producers ;
+   for (uint32_t p = 0 ; p < P ; ++p)
+      producers.emplace_back([&, p] {                           // odd ones: in batches of 16, a single push each
+         for (uint32_t i = 0 ; i < K ; i += p % 2 ? 16 : 1) {
+            if (p % 2 == 0) { refused += !timer.register_event(event(p * K + i)) ; continue ; }
+            std::vector<cWTimerEvent_>   evs ;
+            for (uint32_t j = i ; j < i + 16 && j < K ; ++j)   evs.push_back(event(p * K + j)) ;
+            for (auto& h : timer.register_events(std::move(evs)))   refused += !h ;
+         }
+         ++done ;
+      }) ;
+   while (done < P)   timer.advance(1) ;                        // draining as they post
+   for (auto& t : producers)   t.join() ;
+   timer.advance(10) ;                                          // the last ones posted: drained & fired
+
+   auto   st = timer.stats() ;
+   auto   a = timer.register_event(cWTimerEvent_{50, false, do_nothing, true}) ;   // queued requests: registrations
+   auto   b = timer.register_event(cWTimerEvent_{50, false, do_nothing, true}) ;   // ... counted as posted only
+   bool   ran = false ;
+   timer.register_event(cWTimerEvent_{1, false, [&] {            // at the end of its tick: 3 posted, 2 requests
+      std::thread{[&] {
+         for (int i = 0 ; i < 3 ; ++i)   timer.register_event(cWTimerEvent_{5, false, do_nothing, true}) ;
+         timer.cancel(a), timer.reschedule(b, 7) ;
+      }}.join() ;
+      ran = true ;
+   }, true}) ;
+   while (!ran)   timer.advance(1) ;
+   auto   queued = timer.stats() ;
+   timer.advance(1) ;
+   auto   drained = timer.stats() ;
+   bool   ok = refused == 0 && st._fired == P * K && st._scheduled == 0 && st._posted == 0
+               && queued._posted == 3 && queued._scheduled == 2 && drained._posted == 0 && drained._scheduled == 4
+               && std::all_of(fired.begin(), fired.end(), [](uint32_t n) { return n == 1 ; }) ;
+   Log_to(0, "> posting: ", P, " producers, ", P * K, " events posted, ", st._fired, " fired, ",
+             std::count(fired.begin(), fired.end(), 1), " exactly once: ", ok ? "OK" : "FAILED") ;
+   return ok ;
+}
+
+static int threads_now()                                       // of this process: /proc/self/status
+{
+   std::ifstream   st{"/proc/self/status"} ;
+   for (std::string line ; std::getline(st, line) ; )
+      if (line.compare(0, 8, "Threads:") == 0)   return std::atoi(line.c_str() + 8) ;
+   return -1 ;
+}
+
+bool test_dispatch()                                           // workers: by the 1st dispatch; move-only & recurrent: refused
+{                                                               // ... copyable: a copy as registered per firing, inlay: kept
+   using namespace std::chrono_literals ;
+   std::atomic<bool>   once{false} ;
+   std::atomic<int>    fires{0}, fresh{0}, kept{0}, kept_fires{0} ;
+   cWTimer_   timer{64, 1, 0, false, "Dispatch_Test"} ;
+   timer.log_ticks(false), timer.set_dispatch(2) ;
+
+   bool   refused = !timer.register_event(cWTimerEvent_{1, true, [p = std::make_unique<int>(0)] { ++*p ; }}) ;
+   bool   inlay = (bool)timer.register_event(cWTimerEvent_{1, true, [p = std::make_unique<int>(0)] { ++*p ; }, true}) ;
+   timer.register_event(cWTimerEvent_{100, false, [&once, p = std::make_unique<int>(0)] { once = true ; }}) ;
+   timer.register_event(cWTimerEvent_{5, true, [n = 0, p = &kept, f = &kept_fires]() mutable { *p = ++n, ++*f ; }, true}) ;
+
+   auto   before = threads_now() ;
+   timer.start() ;
+   std::this_thread::sleep_for(50ms) ;
+   auto   idle = threads_now() - before ;                       // the Timer's only: nothing dispatched yet
+   timer.register_event(cWTimerEvent_{5, true, [n = 0, p = &fresh, f = &fires]() mutable { ++*f ; if (++n == 1) ++*p ; }}) ;
+   std::this_thread::sleep_for(150ms) ;
+   auto   busy = threads_now() - before ;                       // ... and the workers
+   timer.stop() ;
+
+   std::this_thread::sleep_for(10ms) ;                          // the last ones dispatched: executed
+
+   bool   ok = refused && inlay && once && idle == 1 && busy == 3
+               && fires > 0 && fresh == fires && kept_fires > 0 && kept == kept_fires ;
+   Log_to(0, "> dispatch: move-only & recurrent refused ", refused, ", inlay taken ", inlay, ", one-time fired ", once.load(),
+             "; threads: ", idle, " idle, ", busy, " dispatching; state: a copy per firing ", fresh.load(), " of ", fires.load(),
+             ", inlay kept ", kept.load(), " of ", kept_fires.load(), ": ", ok ? "OK" : "FAILED") ;
+   return ok ;
+}
+
 int main()
 {
    Log_to(0, "> Wheel TIMER testing ...", LOG_TIME_LAPSE(Log_start()), '\n') ;
 
+   if (!test_steady_state_allocations())   return 1 ;
+   if (!test_tickless())   return 1 ;
+   if (!test_histogram())   return 1 ;
+   if (!test_stats())   return 1 ;
+   if (!test_virtual_clock())   return 1 ;
+   if (!test_overrun())   return 1 ;
+   if (!test_trace())   return 1 ;
+   if (!test_static())   return 1 ;
+   if (!test_slack())   return 1 ;
+   if (!test_tick_sources())   return 1 ;
+   if (!test_hybrid())   return 1 ;
+   if (!test_dispatch())   return 1 ;
+   if (!test_group())   return 1 ;
+   if (!test_bulk_registration())   return 1 ;
+   if (!test_handles())   return 1 ;
+   if (!test_posting())   return 1 ;
+
    {  // Timer's Life block
-      // 10 slots, period: 1 sec, delay correction 150 micros, debug capacity 150,
+      // 10 slots, period: 50 millis, no delay correction (absolute deadlines), debug histograms on
       uint32_t   period = 50 ;
-      cWTimer_   timer{10, period, 170, 500, "Wheel_Timer_I"} ;
+      cWTimer_   timer{10, period, 0, true, "Wheel_Timer_I"} ;
                                                                // Log_to(0, "> Timer created as: ", timer, '\n') ;
 
       AppCB_   cb1{func} ;